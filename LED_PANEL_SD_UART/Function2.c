@@ -7,133 +7,156 @@
 
 #include "global.h"
 #include "WS2812.h"
+#include "profile.h"
+#include "scheduler.h"
 
 int incmult(int);
 
 // define MAXVimum brightness to fade to?
 #define MAXV   50
+// one step of the fade per frame, output_grb3 alone takes 14.0ms
+#define F2_FRAME_MS 16
 enum {S_R, S_O, S_G, S_B, S_Y, S_V, S_T};
 
-void Function2 () 
+static int mult;
+static u08 state;
+static u08 val;
+static u08 first_time;
+
+// start from the first LED, a frame every F2_FRAME_MS
+void Function2Start(void)
 {
-	int mult = 0;
-	u08 state = S_R;
-	u08 val = 0;
-	u08 first_time = 1;
-	u08 buf[NUM_LEDS];
-	while(int_flag == 0)
+	mult = 0;
+	state = S_R;
+	val = 0;
+	first_time = 1;
+	schedSetFramePeriod(F2_FRAME_MS); // needs schedInit() first
+}
+
+// one frame: send buf (the upper string) and take the fade a step on.
+// Call it when schedFrameDue(), it returns to the loop in between
+void Function2Frame(u08 * buf)
+{
+	u16 t; // profile time stamp, needs profileInit() first
+	u08 effect; // state being profiled
+
+	// at the 'l' level and within the power limit, like the pictures
+	t = profileStart();
+	power_measure(STRING_UPPER, buf);
+	dither_frame();
+	output_grb3_chunked(buf, NUM_LEDS);
+	profileStop(PROF_OUTPUT, t);
+	
+	effect = state;
+	t = profileStart();
+	switch (state)
 	{
-		output_grb(buf, sizeof(buf));
-		
-		switch (state)
+		case S_R:
+		if ((val=val+1) <= MAXV)
 		{
-			case S_R:
-			if ((val=val+1) <= MAXV)
-			{
-				if (!first_time)
-				{
-					/*set_color(buf, mult+5, val, MAXV-val, MAXV-val);*/
-				}
-				set_color(buf, mult, val, val, val);
-			}
-			else
+			if (!first_time)
 			{
-				first_time = 0;
-				/*state = S_G;*/
-				state = S_O;
-				val = 0;
+				/*set_color(buf, mult+5, val, MAXV-val, MAXV-val);*/
 			}
-			break;
-			
-			case S_O:
-			if ((val=val+1) <= MAXV)
-			{
-				set_color(buf, mult+1, 0, 0, 0);
-			}
-			else
-			{
-				state = S_R;
-				val = 0; mult=incmult(mult+1);
-			}
-			break;
-			
-			case S_G:
-			if (++val <= MAXV)
-			{
-				set_color(buf, mult+0, MAXV-val, val, 0);
-				set_color(buf, mult+1, 0, val, 0);
-			}
-			else
-			{
-				state = S_B;
-				val = 0;
-			}
-			break;
-			
-			case S_B:
-			if (++val <= MAXV)
-			{
-				set_color(buf, mult+1, 0, MAXV-val, val);
-				set_color(buf, mult+2, 0, 0, val);
-			}
-			else
-			{
-				state = S_Y;
-				val = 0;
-			}
-			break;
-			
-			case S_Y:
-			if (++val <= MAXV)
-			{
-				set_color(buf, mult+2, val, 0, MAXV-val);
-				set_color(buf, mult+3, val, val, 0);
-			}
-			else
-			{
-				state = S_V;
-				val = 0;
-			}
-			break;
-			
-			case S_V:
-			if (++val <= MAXV)
-			{
-				set_color(buf, mult+3, MAXV-val, MAXV-val, val);
-				set_color(buf, mult+4, val, 0, val);
-			}
-			else
-			{
-				state = S_T;
-				val = 0;
-			}
-			break;
-			
-			case S_T:
-			if (++val <= MAXV)
-			{
-				set_color(buf, mult+4, MAXV-val, val, MAXV-val);
-				set_color(buf, mult+5, 0, val, val);
-			}
-			else
-			{
-				state = S_R;
-				val = 0;
-			}
-			break;
-			
-			default:
+			set_color(buf, mult, val, val, val);
+		}
+		else
+		{
+			first_time = 0;
+			/*state = S_G;*/
+			state = S_O;
+			val = 0;
+		}
+		break;
+		
+		case S_O:
+		if ((val=val+1) <= MAXV)
+		{
+			set_color(buf, mult+1, 0, 0, 0);
+		}
+		else
+		{
+			state = S_R;
+			val = 0; mult=incmult(mult+1);
+		}
+		break;
+		
+		case S_G:
+		if (++val <= MAXV)
+		{
+			set_color(buf, mult+0, MAXV-val, val, 0);
+			set_color(buf, mult+1, 0, val, 0);
+		}
+		else
+		{
+			state = S_B;
+			val = 0;
+		}
+		break;
+		
+		case S_B:
+		if (++val <= MAXV)
+		{
+			set_color(buf, mult+1, 0, MAXV-val, val);
+			set_color(buf, mult+2, 0, 0, val);
+		}
+		else
+		{
+			state = S_Y;
+			val = 0;
+		}
+		break;
+		
+		case S_Y:
+		if (++val <= MAXV)
+		{
+			set_color(buf, mult+2, val, 0, MAXV-val);
+			set_color(buf, mult+3, val, val, 0);
+		}
+		else
+		{
+			state = S_V;
+			val = 0;
+		}
+		break;
+		
+		case S_V:
+		if (++val <= MAXV)
+		{
+			set_color(buf, mult+3, MAXV-val, MAXV-val, val);
+			set_color(buf, mult+4, val, 0, val);
+		}
+		else
+		{
+			state = S_T;
+			val = 0;
+		}
+		break;
+		
+		case S_T:
+		if (++val <= MAXV)
+		{
+			set_color(buf, mult+4, MAXV-val, val, MAXV-val);
+			set_color(buf, mult+5, 0, val, val);
+		}
+		else
+		{
 			state = S_R;
-			break;
+			val = 0;
 		}
+		break;
 		
-		_delay_ms(1);
+		default:
+		state = S_R;
+		break;
 	}
+	profileStop(PROF_BUILD, t);
+	profileFrame(PROF_EFFECT(effect));
 }
 
 int incmult(int mult)
 {
-	if (mult<NUM_LEDS)
+	if (mult+7 < NUM_WS2812) // set_color() goes up to mult+5
 	{
 		mult=mult+2;
 	}
@@ -1,13 +1,604 @@
 
 #include <stdint.h>
+#include <avr/io.h>
+#include <avr/pgmspace.h>
 #include "global.h"
 #include "WS2812.h"
+#include "profile.h"
 
+// read directly by the output routines, use set_brightness() elsewhere
+u08 led_brightness = 255;
 
-void set_color(u08 * p_buf, u08 led, u08 r, u08 g, u08 b)
+void set_brightness(u08 level)
+{
+	if (level != led_brightness) {
+		mark_all_dirty(); // every byte goes out scaled by it
+	}
+	led_brightness = level;
+}
+
+u08 get_brightness(void)
+{
+	return led_brightness;
+}
+
+// read directly by the output routines, use set_dither() elsewhere
+u08 led_dither; // threshold for the next byte, carried from one output to the next
+u08 led_dither_step; // added to it after each byte, 0 = no dithering
+u08 dither_phase; // led_dither at the start of the frame
+
+// both odd, so each byte gets every threshold once in 256 frames, and
+// about 0.38 and 0.62 of 256 so neighbouring bytes and frames spread out
+#define DITHER_BYTE_STEP  0x61
+#define DITHER_FRAME_STEP 0x9F
+
+void set_dither(u08 on)
+{
+	if (on) {
+		led_dither_step = DITHER_BYTE_STEP;
+	} else {
+		led_dither_step = 0;
+		led_dither = 0; // plain truncation
+	}
+	mark_all_dirty();
+}
+
+u08 get_dither(void)
+{
+	return (led_dither_step != 0);
+}
+
+void dither_frame(void)
+{
+	if (led_dither_step) {
+		dither_phase += DITHER_FRAME_STEP;
+		led_dither = dither_phase;
+		mark_all_dirty();
+	}
+}
+
+u08 get_dither_phase(void)
+{
+	return dither_phase;
+}
+
+u08 get_dither_step(void)
+{
+	return led_dither_step;
+}
+
+u16 power_budget; // mA per string, 0 = no limit
+u32 power_sum[2]; // sum of each string's bytes, see power_string()
+u08 power_limit[2] = {255, 255}; // highest brightness the budget allows
+
+// estimated current of a string, mA
+static u16 power_ma(u32 sum, u08 level)
+{
+	return POWER_IDLE_MA + sum*level/256*POWER_CHANNEL_MA/255;
+}
+
+void set_power_budget(u16 ma)
+{
+	power_budget = ma;
+	power_string(STRING_UPPER, power_sum[STRING_UPPER]);
+	power_string(STRING_LOWER, power_sum[STRING_LOWER]);
+}
+
+u16 get_power_budget(void)
+{
+	return power_budget;
+}
+
+void power_string(u08 string, u32 sum)
+{
+	u32 limit = 255;
+
+	power_sum[string] = sum;
+	if (power_budget && (power_ma(sum, 255) > power_budget)) {
+		if (power_budget <= POWER_IDLE_MA) {
+			limit = 0;
+		} else {
+			// power_ma() solved for the level, rounded down
+			limit = (u32)(power_budget - POWER_IDLE_MA)*255*256/POWER_CHANNEL_MA/sum;
+			if (limit > 255) {
+				limit = 255;
+			}
+		}
+	}
+	if (limit != power_limit[string]) {
+		power_limit[string] = limit;
+		mark_dirty(string, NUM_LEDS); // it all goes out at a new level
+	}
+}
+
+void power_measure(u08 string, const u08 * ptr)
+{
+	u32 sum = 0;
+	u16 i;
+
+	for (i=0;i<NUM_LEDS;i++) {
+		sum += ptr[i];
+	}
+	power_string(string, sum);
+}
+
+u32 get_power_sum(u08 string)
+{
+	return power_sum[string];
+}
+
+u16 get_power_estimate(u08 string)
+{
+	return power_ma(power_sum[string], led_brightness);
+}
+
+u08 get_power_limit(u08 string)
+{
+	return power_limit[string];
+}
+
+u16 output_chunk = OUTPUT_CHUNK_DEFAULT; // bytes per chunk, 0 = all at once
+u16 output_cli_max; // longest chunk, Timer1 counts
+u16 output_gap_max; // longest time between chunks
+u16 dirty[2]; // bytes of each string to send, see mark_dirty()
+u08 output_continued; // the chunks after the first of a transfer are going out
+u08 output_scaled; // see set_output_scaled()
+u08 column_offset; // see set_column_offset()
+u08 row_start[YBOUND]; // buffer column each row of a string starts sending from
+
+void set_output_chunk(u16 bytes)
+{
+	output_chunk = bytes;
+}
+
+u16 get_output_chunk(void)
+{
+	return output_chunk;
+}
+
+void set_output_scaled(u08 scaled)
+{
+	output_scaled = scaled;
+}
+
+#define ROW_BYTES (3*XBOUND)
+
+/****************************************************
+ * Where byte at of a string's data is in its buffer,
+ * with the columns rotated by column_offset. n is cut
+ * to what runs on from there without wrapping round
+ * the end of the row in the buffer, or running past
+ * the end of the row as it's sent.
+ */
+static u16 rotated(u16 at, u16 * n)
+{
+	u08 row;
+	u16 sent, col;
+
+	if (!column_offset) {
+		return at;
+	}
+	row = at / ROW_BYTES;
+	sent = at - (u16)row*ROW_BYTES; // of this row
+	col = sent + 3*row_start[row];
+	if (col >= ROW_BYTES) {
+		col -= ROW_BYTES;
+	}
+	if (*n > ROW_BYTES - col) {
+		*n = ROW_BYTES - col;
+	}
+	if (*n > ROW_BYTES - sent) {
+		*n = ROW_BYTES - sent;
+	}
+	return (u16)row*ROW_BYTES + col;
+}
+
+/****************************************************
+ * Timing around each chunk, with interrupts off: the
+ * gap since the chunk before (t_end, not for the
+ * first), then how long the chunk itself took (t).
+ */
+static u16 chunk_begin(u08 first, u16 t_end)
+{
+	u16 t = TCNT1;
+
+	if (!first && ((u16)(t - t_end) > output_gap_max)) {
+		output_gap_max = t - t_end;
+	}
+	return t;
+}
+
+static u16 chunk_end(u16 t)
+{
+	u16 t_end = TCNT1;
+
+	if ((u16)(t_end - t) > output_cli_max) {
+		output_cli_max = t_end - t;
+	}
+	return t_end;
+}
+
+/****************************************************
+ * Only the uart rx ISR runs between chunks, it would
+ * lose bytes otherwise. The tick and the uart tx are
+ * held until the transfer is done, so they don't make
+ * a gap any longer: the tick catches up on the ms it
+ * missed, the tx goes on a bit later.
+ */
+static u08 held_timsk, held_ucsrb;
+
+static void gaps_hold(void)
+{
+	CRITICAL_SECTION_START;
+	held_timsk = TIMSK1 & (1<<OCIE1A);
+	held_ucsrb = UCSR0B & (1<<UDRIE0);
+	TIMSK1 &= ~(1<<OCIE1A);
+	UCSR0B &= ~(1<<UDRIE0);
+	CRITICAL_SECTION_END;
+}
+
+static void gaps_release(void)
+{
+	CRITICAL_SECTION_START;
+	TIMSK1 |= held_timsk;
+	UCSR0B |= held_ucsrb;
+	CRITICAL_SECTION_END;
+}
+
+/****************************************************
+ * Send count bytes from ptr to the PD3 (lane 3), PD4
+ * (lane 4) or both (lane 34, PD4 data at ptr+stride)
+ * strings, output_chunk bytes at a time. Each chunk
+ * runs with interrupts off and timed, in between
+ * they're back to what they were (see gaps_hold()).
+ * The brightness is
+ * held to the strings' power limit meanwhile.
+ */
+static void output_chunked(u08 lane, u08 * ptr, u16 count, u16 stride)
+{
+	u08 first = TRUE;
+	u16 n, t, t_end = 0;
+	u16 sent = 0, at;
+	u08 level = led_brightness;
+	u08 dither = led_dither, step = led_dither_step;
+	u08 limit;
+	
+	if (lane == 3) {
+		limit = power_limit[STRING_UPPER];
+	} else if (lane == 4) {
+		limit = power_limit[STRING_LOWER];
+	} else {
+		limit = MIN(power_limit[STRING_UPPER], power_limit[STRING_LOWER]);
+	}
+	if (output_scaled) {
+		// out = (byte * 255 + 255) >> 8 = byte, unless the limit
+		// takes some of the brightness that's in it back off
+		led_brightness = (limit < level) ? (u16)limit*255/level : 255;
+		led_dither = 255;
+		led_dither_step = 0;
+	} else if (limit < led_brightness) {
+		led_brightness = limit;
+	}
+	gaps_hold();
+	while (count) {
+		n = count;
+		if (output_chunk && (n > output_chunk)) {
+			n = output_chunk;
+		}
+		at = rotated(sent, &n);
+		CRITICAL_SECTION_START;
+		t = chunk_begin(first, t_end);
+		if (lane == 3) {
+			output_grb3(ptr + at, n);
+		} else if (lane == 4) {
+			output_grb4(ptr + at, n);
+		} else {
+			output_grb34s(ptr + at, n, stride);
+		}
+		t_end = chunk_end(t);
+		CRITICAL_SECTION_END; // pending interrupts run here
+		sent += n;
+		count -= n;
+		first = FALSE;
+		output_continued = TRUE;
+	}
+	output_continued = FALSE;
+	gaps_release();
+	led_brightness = level;
+	if (output_scaled) {
+		led_dither = dither;
+		led_dither_step = step;
+	}
+}
+
+void output_grb3_chunked(u08 * ptr, u16 count)
+{
+	output_chunked(3, ptr, count, 0);
+}
+
+void output_grb4_chunked(u08 * ptr, u16 count)
+{
+	output_chunked(4, ptr, count, 0);
+}
+
+void output_grb34_chunked(u08 * ptr, u16 count)
+{
+	output_chunked(34, ptr, count, count);
+}
+
+u16 get_output_cli_max(void)
+{
+	return output_cli_max;
+}
+
+u16 get_output_gap_max(void)
+{
+	return output_gap_max;
+}
+
+void clear_output_max(void)
+{
+	output_cli_max = 0;
+	output_gap_max = 0;
+}
+
+void mark_dirty(u08 string, u16 bytes)
+{
+	if (bytes > NUM_LEDS) {
+		bytes = NUM_LEDS;
+	}
+	if (bytes > dirty[string]) {
+		dirty[string] = bytes;
+	}
+}
+
+void set_dirty(u08 string, u16 bytes)
+{
+	dirty[string] = bytes;
+}
+
+void mark_all_dirty(void)
+{
+	dirty[STRING_UPPER] = NUM_LEDS;
+	dirty[STRING_LOWER] = NUM_LEDS;
+}
+
+u16 get_dirty(u08 string)
+{
+	return dirty[string];
+}
+
+void output_grb3_dirty(u08 * ptr)
+{
+	if (dirty[STRING_UPPER]) {
+		output_chunked(3, ptr, dirty[STRING_UPPER], 0);
+		dirty[STRING_UPPER] = 0;
+	}
+}
+
+void output_grb4_dirty(u08 * ptr)
+{
+	if (dirty[STRING_LOWER]) {
+		output_chunked(4, ptr, dirty[STRING_LOWER], 0);
+		dirty[STRING_LOWER] = 0;
+	}
+}
+
+void output_grb34_dirty(u08 * ptr)
+{
+	// both at once if both changed, the longer one sets the length
+	if (!dirty[STRING_LOWER]) {
+		output_grb3_dirty(ptr);
+	} else if (!dirty[STRING_UPPER]) {
+		output_grb4_dirty(ptr+NUM_LEDS);
+	} else {
+		output_chunked(34, ptr, MAX(dirty[STRING_UPPER], dirty[STRING_LOWER]), NUM_LEDS);
+		dirty[STRING_UPPER] = 0;
+		dirty[STRING_LOWER] = 0;
+	}
+}
+
+/****************************************************
+ * The palette is cut down to the power limit like
+ * output_chunked() does for scaled data, so a string
+ * comes out the same as its GRB bytes would. Chunks
+ * are whole pairs of LEDs, each starts on a byte of
+ * idx.
+ */
+void output_grb_pal4_dirty(u08 string, u08 * idx, const u08 * palette)
+{
+	u08 pal[3*16]; // palette at the power limit
+	u08 limit = power_limit[string];
+	u08 scale, i, first = TRUE;
+	u08 outmask = (string == STRING_UPPER) ? (1 << PIND3) : (1 << PIND4);
+	u16 n, t, t_end = 0, chunk;
+	u16 count = NUM_WS2812;
+
+	if (!dirty[string]) {
+		return;
+	}
+	scale = (limit < led_brightness) ? (u16)limit*255/led_brightness : 255;
+	for (i=0;i<sizeof(pal);i++) {
+		pal[i] = ((u16)palette[i]*scale + 255) >> 8;
+	}
+	chunk = (output_chunk/3) & ~1;
+	if (chunk < 2) {
+		chunk = 2;
+	}
+	gaps_hold();
+	while (count) {
+		n = count;
+		if (output_chunk && (n > chunk)) {
+			n = chunk;
+		}
+		CRITICAL_SECTION_START;
+		t = chunk_begin(first, t_end);
+		output_grb_pal4(idx, n, pal, outmask);
+		t_end = chunk_end(t);
+		CRITICAL_SECTION_END; // pending interrupts run here
+		idx += n/2;
+		count -= n;
+		first = FALSE;
+		output_continued = TRUE;
+	}
+	output_continued = FALSE;
+	gaps_release();
+	dirty[string] = 0;
+}
+
+u08 output_pal4_fits(void)
+{
+	return !output_chunk || (output_chunk >= 6);
+}
+
+#if (PANEL_WIRING != WIRING_ROW_MAJOR) && (PANEL_WIRING != WIRING_SERPENTINE)
+#error "set_column_offset needs the strings wired in rows"
+#endif
+
+void set_column_offset(u08 offset)
+{
+	u08 y;
+	u16 a, b;
+
+	offset %= XBOUND;
+	if (offset == column_offset) {
+		return;
+	}
+	column_offset = offset;
+	for (y=0;y<YBOUND;y++) {
+		// a row sends x = 0 first, or x = XBOUND-1 first
+		a = pixel_led(0, y);
+		b = pixel_led(XBOUND-1, y);
+		if (a < b) {
+			row_start[a / XBOUND] = offset;
+		} else {
+			row_start[b / XBOUND] = offset ? XBOUND - offset : 0;
+		}
+	}
+	mark_all_dirty(); // every LED shows another pixel now
+}
+
+u08 get_column_offset(void)
+{
+	return column_offset;
+}
+
+u08 column_x(u08 x)
+{
+	x += column_offset;
+	if (x >= XBOUND) {
+		x -= XBOUND;
+	}
+	return x;
+}
+
+void set_color(u08 * p_buf, u16 led, u08 r, u08 g, u08 b)
 {
 	u16 index = 3*led;
 	p_buf[index++] = g;
 	p_buf[index++] = r;
 	p_buf[index] = b;
-}
\ No newline at end of file
+}
+
+/****************************************************
+ * Pixel map, worked out by the compiler.
+ *
+ * PM_LED(x, y) is the LED number of a pixel for the
+ * configured wiring. PM_n(p) expands it for n pixels
+ * from pixel p, and the #if chain below adds up the
+ * powers of two in PANEL_PIXELS, so the table is the
+ * right size for any panel up to 2047 pixels.
+ */
+#if PANEL_PIXELS > 2047
+#error "pixel_map is only built for up to 2047 pixels"
+#endif
+
+#define PM_X(x)    (PANEL_FLIP_X ? XBOUND-1-(x) : (x))
+#define PM_ROW(y)  (PANEL_FLIP_Y ? YBOUND-1-((y)%YBOUND) : ((y)%YBOUND))
+#define PM_POS(x, y) \
+	(PANEL_WIRING == WIRING_ROW_MAJOR ? PM_ROW(y)*XBOUND + PM_X(x) : \
+	 PANEL_WIRING == WIRING_SERPENTINE ? PM_ROW(y)*XBOUND + \
+		((PM_ROW(y) & 1) ? XBOUND-1-PM_X(x) : PM_X(x)) : \
+	 PANEL_WIRING == WIRING_COLUMN_MAJOR ? PM_X(x)*YBOUND + PM_ROW(y) : \
+	 PM_X(x)*YBOUND + ((PM_X(x) & 1) ? YBOUND-1-PM_ROW(y) : PM_ROW(y)))
+#define PM_LED(x, y) (((y)/YBOUND)*(XBOUND*YBOUND) + PM_POS(x, y))
+
+#define PM_1(p)    PM_LED((p)%XBOUND, (p)/XBOUND),
+#define PM_2(p)    PM_1(p)   PM_1((p)+1)
+#define PM_4(p)    PM_2(p)   PM_2((p)+2)
+#define PM_8(p)    PM_4(p)   PM_4((p)+4)
+#define PM_16(p)   PM_8(p)   PM_8((p)+8)
+#define PM_32(p)   PM_16(p)  PM_16((p)+16)
+#define PM_64(p)   PM_32(p)  PM_32((p)+32)
+#define PM_128(p)  PM_64(p)  PM_64((p)+64)
+#define PM_256(p)  PM_128(p) PM_128((p)+128)
+#define PM_512(p)  PM_256(p) PM_256((p)+256)
+#define PM_1024(p) PM_512(p) PM_512((p)+512)
+
+const u16 pixel_map[PANEL_PIXELS] PROGMEM = {
+#if PANEL_PIXELS & 1024
+	PM_1024(0)
+#endif
+#if PANEL_PIXELS & 512
+	PM_512(PANEL_PIXELS & 1024)
+#endif
+#if PANEL_PIXELS & 256
+	PM_256(PANEL_PIXELS & 1536)
+#endif
+#if PANEL_PIXELS & 128
+	PM_128(PANEL_PIXELS & 1792)
+#endif
+#if PANEL_PIXELS & 64
+	PM_64(PANEL_PIXELS & 1920)
+#endif
+#if PANEL_PIXELS & 32
+	PM_32(PANEL_PIXELS & 1984)
+#endif
+#if PANEL_PIXELS & 16
+	PM_16(PANEL_PIXELS & 2016)
+#endif
+#if PANEL_PIXELS & 8
+	PM_8(PANEL_PIXELS & 2032)
+#endif
+#if PANEL_PIXELS & 4
+	PM_4(PANEL_PIXELS & 2040)
+#endif
+#if PANEL_PIXELS & 2
+	PM_2(PANEL_PIXELS & 2044)
+#endif
+#if PANEL_PIXELS & 1
+	PM_1(PANEL_PIXELS & 2046)
+#endif
+};
+
+u16 pixel_led(u08 x, u08 y)
+{
+	return pgm_read_word(&pixel_map[y*XBOUND + x]);
+}
+
+void set_color_xy(u08 * p_buf, u08 x, u08 y, u08 r, u08 g, u08 b)
+{
+	set_color_xy_in(p_buf, 0, PANEL_PIXELS, x, y, r, g, b);
+}
+
+void set_color_xy_in(u08 * p_buf, u16 first_led, u16 leds, u08 x, u08 y, u08 r, u08 g, u08 b)
+{
+	u16 led = pixel_led(x, y);
+	u08 * p;
+
+	if ((led < first_led) || (led - first_led >= leds)) {
+		return; // not in this buffer
+	}
+	p = p_buf + 3*(led - first_led);
+	if ((p[0] != g) || (p[1] != r) || (p[2] != b)) {
+		p[0] = g;
+		p[1] = r;
+		p[2] = b;
+		// bytes up to the end of this LED, counted from the string's start
+		if (led < NUM_WS2812) {
+			mark_dirty(STRING_UPPER, 3*(led+1));
+		} else {
+			mark_dirty(STRING_LOWER, 3*(led-NUM_WS2812+1));
+		}
+	}
+}
@@ -6,23 +6,239 @@
 #define YBOUND 11 // NOTE this is 1/2 the screen height. The screen is split into two strings of LEDs, an upper half and lower half.
 
 // define the number of pixels
-#define NUM_WS2812    XBOUND*YBOUND
+#define NUM_WS2812    (XBOUND*YBOUND)
 // define the number of RGB elements
 #define NUM_LEDS      (NUM_WS2812*3)
+// pixels on the whole panel, both strings
+#define PANEL_PIXELS  (2*XBOUND*YBOUND)
+
+// Panel wiring: how each string runs through its half of the panel.
+// x runs 0..XBOUND-1, y runs 0..2*YBOUND-1 with y = 0 the first row of
+// the upper (PD3) string. FLIP_X/FLIP_Y mirror the start corner.
+enum {
+  WIRING_ROW_MAJOR,         // every row runs the same way
+  WIRING_SERPENTINE,        // rows alternate direction
+  WIRING_COLUMN_MAJOR,      // every column runs the same way
+  WIRING_COLUMN_SERPENTINE  // columns alternate direction
+};
+#define PANEL_WIRING  WIRING_ROW_MAJOR
+#define PANEL_FLIP_X  1 // first LED of each row is at x = XBOUND-1
+#define PANEL_FLIP_Y  0
 
 // declaration of ASM function to output self-clocking LED data.
 // NOTE: 3 outputs on PD3, 4 outputs on PD4. That's the only difference!
+// Both scale every byte by the global brightness (see set_brightness),
+// and dither it if that's on (see set_dither).
 extern void output_grb3(u08 * ptr, u16 count);
 extern void output_grb4(u08 * ptr, u16 count);
 
-// Same as grb3; provided for library compatibility only
+// PD3 like grb3, but the bytes go out as they are: no brightness, no
+// dithering, no power limit. Provided for library compatibility only
 extern void output_grb(u08 * ptr, u16 count);
 
+// Dual-lane output: PD3 and PD4 in the same bit loop, so a whole frame
+// goes out in the time of one half. ptr holds 2*count bytes, the PD3
+// string's data first, then the PD4 string's data.
+extern void output_grb34(u08 * ptr, u16 count);
+// Same, with the PD4 string's data at ptr+stride
+extern void output_grb34s(u08 * ptr, u16 count, u16 stride);
+
+// Palette-indexed output: idx holds one palette index per LED, palette
+// holds 3 bytes (G, R, B) per entry and is looked up as the bits go out.
+// A whole 40x22 frame fits in NUM_WS2812*2 bytes this way. outmask picks
+// the pin, ie. (1 << PIND3) for the upper string. Brightness isn't
+// applied here; scale the palette instead. Fill palette entries
+// with set_color(palette, index, r, g, b).
+extern void output_grb_pal(u08 * idx, u16 count, u08 * palette, u08 outmask);
+// Same with a 16 entry palette and 4 bit indices, two LEDs per byte with
+// the first in the high nibble: a whole frame in NUM_WS2812 bytes. The
+// pictures go out this way with half a panel of buffer, see
+// output_grb_pal4_dirty()
+extern void output_grb_pal4(u08 * idx, u16 count, u08 * palette, u08 outmask);
+
+// Define this to build and send the whole panel in one pass with
+// output_grb34. It needs a full panel buffer (2*NUM_LEDS bytes), which
+// doesn't fit in a 328P next to the UART buffers, so it's off by default.
+//#define WS2812_DUAL_LANE
+
+/****************************************************
+ * Chunked output. The output routines keep interrupts
+ * off for a whole string, ~15ms, and the uart only
+ * holds 2 bytes. These send chunk bytes at a time and
+ * let the uart rx ISR run in between, the tick and the
+ * uart tx wait until the transfer is done. The data
+ * line just stays low a bit longer meanwhile: one rx
+ * ISR, two at most, on the order of 10us each with a
+ * stream coming in (the 'c' CRC is left to
+ * checkStreamChunk() for that). Chunk 0 sends it all at
+ * once, which also costs the scheduler's tick a few ms.
+ * Until set_output_chunk() it's OUTPUT_CHUNK_DEFAULT.
+ *
+ * That's for LEDs that only take a low of 50us as a
+ * reset, as the WS2812 and WS2812B datasheets before
+ * the B-V5 have it. The B-V5 and the like latch after
+ * as little as 6-9us, so a gap can show half a frame
+ * on them. Don't send the panel anything while frames
+ * go out then, or check 'g' 'i' (the longest gap)
+ * under load.
+ *
+ * The longest chunk (interrupts off) and the longest
+ * gap between chunks are kept, in Timer1 counts (see
+ * profile.h), until clear_output_max().
+ */
+#define OUTPUT_CHUNK_DEFAULT 64 // bytes, 0.7ms
+void set_output_chunk(u16 bytes);
+u16 get_output_chunk(void);
+void output_grb3_chunked(u08 * ptr, u16 count);
+void output_grb4_chunked(u08 * ptr, u16 count);
+void output_grb34_chunked(u08 * ptr, u16 count);
+u16 get_output_cli_max(void);
+u16 get_output_gap_max(void);
+void clear_output_max(void);
+
+/****************************************************
+ * Dirty tracking. The LEDs keep their data until new
+ * data comes, and a shorter transfer only updates the
+ * first LEDs of a string. So a string only needs to
+ * be sent when its data changed, and only up to the
+ * last byte that did. The dirty count is that many
+ * bytes from the start of the string, 0 = up to date.
+ *
+ * set_color_xy() marks what it changes, and so does
+ * set_brightness() (everything). Code that writes a
+ * buffer itself calls mark_dirty(). The *_dirty
+ * outputs send the dirty part, chunked, and clear it;
+ * ptr is the string's data as for output_grb3/4, or
+ * both strings as for output_grb34.
+ */
+#define STRING_UPPER  0 // PD3
+#define STRING_LOWER  1 // PD4
+void mark_dirty(u08 string, u16 bytes);
+// exactly this many, drops what was marked since get_dirty()
+void set_dirty(u08 string, u16 bytes);
+void mark_all_dirty(void);
+u16 get_dirty(u08 string);
+void output_grb3_dirty(u08 * ptr);
+void output_grb4_dirty(u08 * ptr);
+void output_grb34_dirty(u08 * ptr);
+// a string of 4 bit palette indices (output_grb_pal4), all of it if any
+// of it is dirty. The palette has the brightness in it already, as for
+// set_output_scaled(), only the power limit is taken off
+void output_grb_pal4_dirty(u08 string, u08 * idx, const u08 * palette);
+// TRUE if that keeps to the chunk size: it can't go below two LEDs
+u08 output_pal4_fits(void);
+
+/****************************************************
+ * Column offset, for scrolling. With an offset set,
+ * the buffer is a ring of columns: logical column x
+ * is kept in buffer column column_x(x), that is x +
+ * offset wrapping round at XBOUND. The chunked outputs
+ * send each row from there on and wrap round, in two
+ * parts, so the LEDs see it unrotated. Moving the
+ * offset on by one scrolls the whole panel a column
+ * to the left, and only the column coming in on the
+ * right has to be written, into buffer column
+ * column_x(XBOUND-1).
+ *
+ * It takes the strings wired in rows. Dirty marks are
+ * by buffer position, so a new offset marks all dirty
+ * and offset 0 puts it back to a plain buffer.
+ */
+void set_column_offset(u08 offset);
+u08 get_column_offset(void);
+u08 column_x(u08 x);
+
+/****************************************************
+ * Global brightness, applied by output_grb3/4/34 with
+ * a hardware mul as each byte is sent out:
+ * out = (byte * brightness) >> 8. 255 is full.
+ */
+void set_brightness(u08 level);
+u08 get_brightness(void);
+
+/****************************************************
+ * Data that has the brightness in it already, ie. a
+ * picture scaled as it was decoded, rounded once. With
+ * this on the chunked outputs send the bytes as they
+ * are, only the power limit still cuts them down.
+ * Turn it off again for data that isn't scaled.
+ */
+void set_output_scaled(u08 scaled);
+
+/****************************************************
+ * Temporal dithering. The brightness mul above makes
+ * 16 bits and only the top 8 go out, so at a low
+ * brightness a picture is left with a few levels per
+ * colour. With dithering on the low byte rounds the
+ * byte up against a threshold that moves every frame,
+ * so over some frames each LED averages out to the
+ * full (byte * brightness) / 256. No extra RAM, the
+ * precision was there in the mul all along.
+ *
+ * It only works if the frame is sent again and again:
+ * call dither_frame() before each one, it moves the
+ * threshold on and marks both strings dirty.
+ */
+void set_dither(u08 on);
+u08 get_dither(void);
+void dither_frame(void);
+// threshold this frame starts from, and what it moves on per byte, for
+// code that dithers as it scales (see set_output_scaled)
+u08 get_dither_phase(void);
+u08 get_dither_step(void);
+
+/****************************************************
+ * Power limiting. Each string's current is estimated
+ * from the sum of its bytes, taken when it's built:
+ *   mA = idle + sum * brightness/256 * channel/255
+ * If that's over the budget at full brightness, the
+ * string gets a lower brightness limit, and the chunked
+ * outputs send it at the lower of that and the global
+ * brightness. Both strings going out together (lane
+ * 34) get the lower of the two limits.
+ *
+ * The budget is per string, in mA, 0 = no limit.
+ * Estimates are at the global brightness, before any
+ * limiting.
+ */
+#define POWER_CHANNEL_MA   20 // one LED colour at 255
+#define POWER_IDLE_MA      (NUM_WS2812*1) // a string all off, ~1mA per LED
+void set_power_budget(u16 ma);
+u16 get_power_budget(void);
+// sum of a string's bytes, before it goes out
+void power_string(u08 string, u32 sum);
+// same, summed from a string's data at ptr
+void power_measure(u08 string, const u08 * ptr);
+// the sum last given, to change it by what changed
+u32 get_power_sum(u08 string);
+u16 get_power_estimate(u08 string);
+u08 get_power_limit(u08 string);
+
 /****************************************************
  * Set the RGB components of an LED in p_buf, via
  * it's locaiton from the beginning of the string.
  */
-void set_color(u08 * p_buf, u08 led, u08 r, u08 g, u08 b);
+void set_color(u08 * p_buf, u16 led, u08 r, u08 g, u08 b);
+
+/****************************************************
+ * x,y -> LED lookup, from a PROGMEM table built at
+ * compile time from the wiring settings above.
+ * pixel_map[y*XBOUND + x] is the LED number counted
+ * from the start of the upper string, so lower string
+ * LEDs start at NUM_WS2812.
+ */
+extern const u16 pixel_map[PANEL_PIXELS];
+u16 pixel_led(u08 x, u08 y);
+
+/****************************************************
+ * Set the RGB components of the pixel at x, y in a
+ * whole panel buffer (upper string then lower string),
+ * and mark it dirty if that changed it.
+ */
+void set_color_xy(u08 * p_buf, u08 x, u08 y, u08 r, u08 g, u08 b);
+// Same, in a buffer that holds leds LEDs from first_led
+// on, ie. one string. Pixels outside it are left out.
+void set_color_xy_in(u08 * p_buf, u16 first_led, u16 leds, u08 x, u08 y, u08 r, u08 g, u08 b);
 
 volatile u08 int_flag;
 
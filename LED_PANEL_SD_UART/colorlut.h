@@ -0,0 +1,40 @@
+// Generated by gammalut, do not edit.
+// gamma 2.20, white 255,176,240 (R,G,B)
+
+const uint16_t gamma_curve[256] PROGMEM = {
+	0x0000, 0x0000, 0x0002, 0x0004, 0x0007, 0x000b, 0x0011, 0x0018,
+	0x0020, 0x002a, 0x0035, 0x0041, 0x004f, 0x005e, 0x006f, 0x0081,
+	0x0094, 0x00a9, 0x00c0, 0x00d8, 0x00f2, 0x010e, 0x012b, 0x014a,
+	0x016a, 0x018c, 0x01b0, 0x01d5, 0x01fc, 0x0225, 0x024f, 0x027b,
+	0x02a9, 0x02d9, 0x030b, 0x033e, 0x0373, 0x03aa, 0x03e3, 0x041d,
+	0x0459, 0x0497, 0x04d7, 0x0519, 0x055d, 0x05a3, 0x05ea, 0x0633,
+	0x067f, 0x06cc, 0x071b, 0x076c, 0x07bf, 0x0814, 0x086b, 0x08c3,
+	0x091e, 0x097b, 0x09d9, 0x0a3a, 0x0a9d, 0x0b01, 0x0b68, 0x0bd0,
+	0x0c3b, 0x0ca8, 0x0d16, 0x0d87, 0x0dfa, 0x0e6e, 0x0ee5, 0x0f5e,
+	0x0fd9, 0x1056, 0x10d5, 0x1156, 0x11da, 0x125f, 0x12e6, 0x1370,
+	0x13fb, 0x1489, 0x1519, 0x15ab, 0x163f, 0x16d5, 0x176e, 0x1808,
+	0x18a5, 0x1944, 0x19e5, 0x1a88, 0x1b2d, 0x1bd4, 0x1c7e, 0x1d2a,
+	0x1dd8, 0x1e88, 0x1f3a, 0x1fef, 0x20a6, 0x215f, 0x221a, 0x22d7,
+	0x2397, 0x2459, 0x251d, 0x25e3, 0x26ac, 0x2776, 0x2843, 0x2913,
+	0x29e4, 0x2ab8, 0x2b8e, 0x2c66, 0x2d41, 0x2e1e, 0x2efd, 0x2fde,
+	0x30c2, 0x31a8, 0x3290, 0x337b, 0x3468, 0x3557, 0x3648, 0x373c,
+	0x3832, 0x392b, 0x3a25, 0x3b22, 0x3c22, 0x3d24, 0x3e28, 0x3f2e,
+	0x4037, 0x4142, 0x424f, 0x435f, 0x4471, 0x4586, 0x469d, 0x47b6,
+	0x48d2, 0x49f0, 0x4b10, 0x4c33, 0x4d58, 0x4e7f, 0x4fa9, 0x50d6,
+	0x5204, 0x5335, 0x5469, 0x559f, 0x56d7, 0x5812, 0x594f, 0x5a8e,
+	0x5bd0, 0x5d15, 0x5e5c, 0x5fa5, 0x60f1, 0x623f, 0x638f, 0x64e2,
+	0x6638, 0x6790, 0x68ea, 0x6a47, 0x6ba6, 0x6d08, 0x6e6c, 0x6fd3,
+	0x713c, 0x72a7, 0x7415, 0x7586, 0x76f9, 0x786e, 0x79e6, 0x7b61,
+	0x7cde, 0x7e5d, 0x7fdf, 0x8164, 0x82ea, 0x8474, 0x8600, 0x878e,
+	0x891f, 0x8ab3, 0x8c49, 0x8de1, 0x8f7c, 0x911a, 0x92ba, 0x945d,
+	0x9602, 0x97a9, 0x9954, 0x9b00, 0x9cb0, 0x9e62, 0xa016, 0xa1cd,
+	0xa386, 0xa542, 0xa701, 0xa8c2, 0xaa86, 0xac4c, 0xae15, 0xafe1,
+	0xb1af, 0xb37f, 0xb552, 0xb728, 0xb900, 0xbadb, 0xbcb9, 0xbe99,
+	0xc07b, 0xc261, 0xc449, 0xc633, 0xc820, 0xca10, 0xcc02, 0xcdf7,
+	0xcfee, 0xd1e8, 0xd3e5, 0xd5e4, 0xd7e6, 0xd9eb, 0xdbf2, 0xddfc,
+	0xe008, 0xe217, 0xe429, 0xe63d, 0xe854, 0xea6e, 0xec8a, 0xeea9,
+	0xf0ca, 0xf2ee, 0xf515, 0xf73f, 0xf96b, 0xfb9a, 0xfdcb, 0xffff,
+};
+
+// G, R, B
+const uint8_t color_white[3] PROGMEM = {176, 255, 240};
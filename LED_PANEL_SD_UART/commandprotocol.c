@@ -10,10 +10,10 @@
 
 
 #include <avr/io.h>
-#include <stdio.h>
 #include <string.h>
 #include <avr/eeprom.h>
 #include <avr/pgmspace.h>
+#include <util/crc16.h>
 #include "global.h"
 #include "commandprotocol.h"
 #include <util/delay.h> // FOR DEBUGGING ONLY!!!
@@ -26,9 +26,53 @@ volatile u08 rxAddressed; // indicate whether this unit was addressed by master
 volatile u08 rxAddrGlobal; // Do Not Transmit if global address was found
 volatile u08 rxCommandProcessing; // command processing latch (started, not complete)
 volatile u08 rxCommandOverloaded; // state when we are addressed while already busy
+volatile u08 rxByteCount; // bytes seen by the rx ISR, wraps
+volatile u08 rxCmdStart; // uartRxBuffer head at the header of the cmd coming in
+volatile u08 rxCmdGlobal; // it came with the global address
+volatile u08 rxCmdOk; // all of it fitted in the ring so far
+volatile u08 rxCmdEnd; // head after the last byte of the last whole cmd
+u08 cmdPos; // next byte of the cmd being processed, a ring counter like tail
+u08 cmdEnd; // and the end of it
 u08 myAddress; // in-memory storage of EEPROM address.
 u08 flg_forceGlobalCmdResponse;
-char cmdprotprintbuf[80]; // output message buffer
+u08 rspLen; // bytes of the reply so far, past the tx ring's head
+char rspLast; // the last of them
+
+// for rspDec, biggest first
+const u32 rspPowers[] PROGMEM = {
+  1000000000, 100000000, 10000000, 1000000, 100000, 10000, 1000, 100, 10
+};
+
+// header byte of a cmd in the rx ring: its length, and this if it came
+// with the global address
+#define CMDPROT_HDR_GLOBAL  0x80
+
+// binary stream ('f' command) state, used by the rx ISR
+u08 * streamBuf[CMDPROT_STREAM_TARGETS]; // registered target buffers
+u16 streamSize[CMDPROT_STREAM_TARGETS];
+volatile u08 rxStreaming; // rest of this cmd is nibble-encoded stream data
+volatile u08 rxStreamNibbles; // header nibbles seen so far
+volatile u08 rxStreamHigh; // high nibble of the data byte in progress, 0xFF if none
+volatile u08 rxStreamTarget;
+volatile u16 rxStreamStart; // offset into the target buffer
+volatile u16 rxStreamCount; // data bytes written
+volatile u08 rxStreamError;
+volatile u08 rxStreamsBegun; // see getStreamsBegun()
+u08 * volatile rxStreamPtr; // next byte to write
+u08 * volatile rxStreamEnd; // end of the target buffer
+// 'c' chunks, see commandprotocol.h
+#define CMDPROT_STREAM_HDR      5 // 'f' header nibbles
+#define CMDPROT_CHUNK_FIELDS    11 // 'c' header nibbles before its CRC
+#define CMDPROT_CHUNK_HDR       15 // and with it
+volatile u08 rxStreamChecked; // it's a 'c' chunk
+volatile u08 rxStreamHdr; // CMDPROT_CHUNK_OK once its header checked out
+volatile u08 rxStreamSeq;
+volatile u16 rxStreamLen; // data bytes the header says
+volatile u16 rxStreamCrc; // of the header, up to its CRC
+volatile u16 rxStreamCrcIn; // the one that came with the header, then the chunk
+volatile u08 rxStreamCrcNibbles;
+u08 streamNaked[32]; // a bit for each sequence number NAKed
+u08 streamNaks;
 
 
 // function prototypes, internal to library
@@ -38,6 +82,7 @@ void setAddressInitialized(void);
 u08 isMyAddress(u08);
 u08 isGlobalAddress(u08);
 void myUartRx(unsigned char);
+void streamRxNibble(unsigned char);
 
 
 
@@ -55,6 +100,7 @@ void initCommandProtocolLibrary(void) {
   rxAddrGlobal = FALSE;
   rxCommandOverloaded = FALSE;
   flg_forceGlobalCmdResponse = FALSE;
+  rxStreaming = FALSE;
   // Chain Command Handler routine to intercept UART receives in ISR
   uartSetRxHandler(myUartRx);
   // Initialize dynamic variable with saved address or header value
@@ -90,18 +136,47 @@ u08 setCommandProtocolAddr(u08 newAddr) {
  * process cmd.
  ************************************************************************/
 u08 isCommandReady(void) {
-  if (rxCompleteFlag) {
+  // whole cmds wait in the ring, there can be more than one
+  if (uartRxBuffer.tail != rxCmdEnd) {
+    return TRUE;
+  }
+  return FALSE;
+}
+
+/************************************************************************
+ * TRUE from the '!' of a cmd for us until its '$'. Mainline shouldn't
+ * turn interrupts off for long in that time, or bytes get lost.
+ ************************************************************************/
+u08 isCommandReceiving(void) {
+  if (rxAddrNext || rxAddressed) {
     return TRUE;
   }
   return FALSE;
 }
 
+/************************************************************************
+ * TRUE from the 'f' or 'c' of a stream for us until its '$', its data
+ * goes into the target buffer meanwhile.
+ ************************************************************************/
+u08 isStreamReceiving(void) {
+  return rxStreaming;
+}
+
 /************************************************************************
  * Set up state to process a command.
  ************************************************************************/
 void beginCmdProcessing(void) {
+  u08 hdr;
+
   rxCommandProcessing = TRUE; // cmd interpretation in progress
   rxCompleteFlag = FALSE; // reset until next cmd comes in
+  // each cmd in the rx ring starts with a header byte: its length, and
+  // CMDPROT_HDR_GLOBAL. It's the bytes from there on, the next cmd can
+  // already be waiting or coming in after it
+  hdr = rBufferGet(&uartRxBuffer);
+  rxAddrGlobal = (hdr & CMDPROT_HDR_GLOBAL) ? TRUE : FALSE;
+  cmdPos = uartRxBuffer.tail;
+  cmdEnd = cmdPos + (hdr & ~CMDPROT_HDR_GLOBAL);
 }
 
 /************************************************************************
@@ -109,25 +184,207 @@ void beginCmdProcessing(void) {
  ************************************************************************/
 void endCmdProcessing(void) {
   sendMsg();
-  bufferClear(&uartRxBuffer,UART_RX_BUFFER_SIZE);
+  rBufferSkip(&uartRxBuffer, cmdEnd - uartRxBuffer.tail); // done with it, not whatever came after
   rxAddrGlobal = FALSE; // reset address state. this was saved to mute responses on global cmds.
   rxCommandProcessing = FALSE; // command interpretation and response done
 }
 
 /*********************************************************************
- * getNextNonNumericChar:
+ * Cmd tokenizer. The cmd is read where the rx ISR put it, a slice of
+ * the uartRxBuffer ring that can wrap round its end, one byte at a time.
+ *********************************************************************/
+u08 cmdMore(void) {
+  return (cmdPos != cmdEnd);
+}
+
+char cmdPeekChar(void) {
+  if (cmdPos == cmdEnd) {
+    return 0;
+  }
+  return uartRxBuffer.dataptr[cmdPos & uartRxBuffer.mask];
+}
+
+char cmdGetChar(void) {
+  char c = cmdPeekChar();
+
+  if (cmdPos != cmdEnd) {
+    cmdPos++;
+  }
+  return c;
+}
+
+/*********************************************************************
+ * cmdGetNum:
+ *
+ * Read a decimal number, up to the next non-digit. 0 if there's no
+ * digit, 0xFFFFFFFF if it's bigger than that.
+ *********************************************************************/
+u32 cmdGetNum(void) {
+  u32 n = 0;
+  u08 d;
+
+  while (cmdPos != cmdEnd) {
+    d = uartRxBuffer.dataptr[cmdPos & uartRxBuffer.mask] - '0';
+    if (d > 9) {
+      break;
+    }
+    if (n > (0xFFFFFFFF - d) / 10) {
+      n = 0xFFFFFFFF;
+    } else {
+      n = n*10 + d;
+    }
+    cmdPos++;
+  }
+  return n;
+}
+
+/*********************************************************************
+ * cmdGetString:
+ *
+ * Copy the rest of the cmd into s, NUL terminated, as much of it as
+ * fits in size bytes. Returns the length copied. The rest of the cmd is
+ * used up either way.
+ *********************************************************************/
+u08 cmdGetString(char *s, u08 size) {
+  u08 len = 0;
+
+  while (cmdPos != cmdEnd) {
+    if (len < size-1) {
+      s[len++] = uartRxBuffer.dataptr[cmdPos & uartRxBuffer.mask];
+    }
+    cmdPos++;
+  }
+  s[len] = 0;
+  return len;
+}
+
+/*********************************************************************
+ * cmdTableInit:
  *
- * Modify the pointer passed in to point to next non-numeric char.
- * We need the argument passed by address so we can modify the
- * caller's storage.
+ * Register a table of cmds, see commandprotocol.h. A letter that's in
+ * it twice gets the first entry.
  *********************************************************************/
-void pointToNextNonNumericChar(unsigned char **ppRxDataStr) {
- /* Count the digits. Numbers are 0x30 < n < 0x39 */
-  while((**ppRxDataStr >= 0x30) & (**ppRxDataStr <= 0x39)) {
-    (*ppRxDataStr)++;
+void cmdTableInit(cmdTable *t, const cmdEntry *entries, u08 count, PGM_P unknown) {
+  u08 i, letter;
+
+  t->entries = entries;
+  t->unknown = unknown;
+  memset(t->index, 0, sizeof(t->index));
+  for (i=count;i>0;i--) { // backwards, so the first one ends up in the index
+    letter = (pgm_read_byte(&entries[i-1].op) & ~0x20) - 'A';
+    if (letter < sizeof(t->index)) {
+      t->index[letter] = i;
+    }
   }
 }
 
+/*********************************************************************
+ * cmdRun:
+ *
+ * Run the handler of the next letter of the cmd. An unknown letter, or
+ * a number that's too big, just sets the reply.
+ *********************************************************************/
+void cmdRun(const cmdTable *t) {
+  cmdEntry e;
+  u08 letter = (cmdGetChar() & ~0x20) - 'A'; // either case, anything else is >= 26
+  u32 n = 0;
+
+  if ((letter >= sizeof(t->index)) || !t->index[letter]) {
+    rspBegin();
+    rspStr_P(t->unknown);
+    return;
+  }
+  memcpy_P(&e, &t->entries[t->index[letter]-1], sizeof(e));
+  if (e.arg == CMDARG_NUM) {
+    n = cmdGetNum();
+    if (n > e.max) {
+      if (e.err) {
+        rspBegin();
+        rspStr_P(e.err);
+      }
+      return;
+    }
+  }
+  e.handler(n);
+}
+
+/************************************************************************
+ * Reply builder. The bytes are written into the tx ring past its head,
+ * where the tx ISR doesn't look, and only added to it by sendMsg(). So a
+ * reply costs no copy, and a muted one is just never added.
+ ************************************************************************/
+void rspBegin(void) {
+  rspLen = 0;
+}
+
+// add a byte, waiting for room if the last reply is still going out
+static void rspPut(char c) {
+  rBuffer *tx = uartGetTxBuffer();
+
+  while (rBufferFree(tx) <= rspLen);
+  rBufferPoke(tx, rspLen++, c);
+  rspLast = c;
+}
+
+void rspChar(char c) {
+  if (rspLen < uartGetTxBuffer()->mask) { // the last byte is kept for the '$'
+    rspPut(c);
+  }
+}
+
+void rspStr(const char *s) {
+  while (*s) {
+    rspChar(*s++);
+  }
+}
+
+void rspStr_P(PGM_P s) {
+  char c;
+
+  while ((c = pgm_read_byte(s++))) {
+    rspChar(c);
+  }
+}
+
+/************************************************************************
+ * rspDec:
+ *
+ * Digits by subtracting powers of ten, which is cheaper than dividing a
+ * u32 on the AVR.
+ ************************************************************************/
+void rspDec(u32 n) {
+  u08 i;
+  u08 started = FALSE;
+  char d;
+  u32 p;
+
+  for (i=0;i<sizeof(rspPowers)/sizeof(rspPowers[0]);i++) {
+    memcpy_P(&p, &rspPowers[i], sizeof(p));
+    for (d='0'; n >= p; d++) {
+      n -= p;
+    }
+    if (started || (d != '0')) {
+      rspChar(d);
+      started = TRUE;
+    }
+  }
+  rspChar('0' + n);
+}
+
+void rspField(u32 n, char sep) {
+  rspDec(n);
+  rspChar(sep);
+}
+
+static char rspHexDigit(u08 nibble) {
+  return (nibble < 10) ? '0' + nibble : 'a' - 10 + nibble;
+}
+
+void rspHex(u08 b) {
+  rspChar(rspHexDigit(b >> 4));
+  rspChar(rspHexDigit(b & 0x0F));
+}
+
 /************************************************************************
  * sendMsg:
  * 
@@ -138,16 +395,114 @@ void sendMsg(void) {
   if (!rxAddrGlobal || flg_forceGlobalCmdResponse) {
     flg_forceGlobalCmdResponse = FALSE;
     // always send a "k" if we're not sending something else.
-    if (strlen(cmdprotprintbuf) == 0) {
-      sprintf_P(cmdprotprintbuf,PSTR("k"));
+    if (rspLen == 0) {
+      rspChar('k');
     }
     // add '$' to terminate message if not done
-    if ( (*(char*)((u16)(&cmdprotprintbuf)+strlen(cmdprotprintbuf)-1) != '$') && (strlen(cmdprotprintbuf) < 79) ) {
-      strcat(cmdprotprintbuf, "$");
+    if (rspLast != '$') {
+      rspPut('$');
     }
-    uartSendBuffer(cmdprotprintbuf,strlen(cmdprotprintbuf));
+    rBufferCommit(uartGetTxBuffer(), rspLen);
+    uartSendTxBuffer();
+  }
+  rspLen = 0;
+}
+
+/************************************************************************
+ * setCommandProtocolStreamBuffer:
+ * 
+ * Tell the library where the 'f' command may write for a given target.
+ * Two targets can share one buffer.
+ ************************************************************************/
+void setCommandProtocolStreamBuffer(u08 target, u08 *buf, u16 size) {
+  if (target < CMDPROT_STREAM_TARGETS) {
+    streamBuf[target] = buf;
+    streamSize[target] = size;
   }
-  memset(cmdprotprintbuf, 0, sizeof(cmdprotprintbuf)); 
+}
+
+/************************************************************************
+ * Stream accessors, valid while processing an 'f' command.
+ ************************************************************************/
+u08 getStreamTarget(void) {
+  return rxStreamTarget;
+}
+
+u16 getStreamStart(void) {
+  return rxStreamStart;
+}
+
+u16 getStreamLength(void) {
+  return rxStreamCount;
+}
+
+u08 getStreamError(void) {
+  // a dangling high nibble means a byte got lost
+  return (rxStreamError || (rxStreamHigh != 0xFF));
+}
+
+u08 getStreamsBegun(void) {
+  return rxStreamsBegun;
+}
+
+void setStreamError(void) {
+  rxStreamError = TRUE;
+}
+
+u08 getStreamSeq(void) {
+  return rxStreamSeq;
+}
+
+/************************************************************************
+ * streamDataCrc:
+ *
+ * A 'c' chunk's CRC, the header's carried on over the data nibbles.
+ * Worked out here from what's in the target, rather than nibble by
+ * nibble in the rx ISR, which runs between output chunks and has to be
+ * short. Only once the header checked out and the data is all in.
+ ************************************************************************/
+static u16 streamDataCrc(void) {
+  u16 crc = rxStreamCrc;
+  const u08 *p = streamBuf[rxStreamTarget] + rxStreamStart;
+  u16 i;
+
+  for (i = 0; i < rxStreamCount; i++, p++) {
+    crc = _crc_ccitt_update(crc, 0x30 | (*p >> 4));
+    crc = _crc_ccitt_update(crc, 0x30 | (*p & 0x0F));
+  }
+  return crc;
+}
+
+u08 checkStreamChunk(void) {
+  u08 bit = 1 << (rxStreamSeq & 7);
+  u08 *naked = &streamNaked[rxStreamSeq >> 3];
+  u08 ok;
+
+  if (!rxStreamChecked) {
+    return CMDPROT_CHUNK_NAKHDR; // it wasn't even a stream
+  }
+  if (rxStreamHdr != CMDPROT_CHUNK_OK) {
+    return rxStreamHdr; // the seq isn't to be trusted, leave the NAKs alone
+  }
+  ok = !getStreamError() && (rxStreamCount == rxStreamLen)
+    && (rxStreamCrcNibbles == 4) && (rxStreamCrcIn == streamDataCrc());
+  if (!ok) {
+    if (!(*naked & bit)) {
+      *naked |= bit;
+      streamNaks++;
+    }
+  } else if (*naked & bit) { // it made it this time
+    *naked &= ~bit;
+    streamNaks--;
+  } else if (rxStreamSeq == 0) { // a new upload
+    memset(streamNaked, 0, sizeof(streamNaked));
+    streamNaks = 0;
+  }
+  return ok ? CMDPROT_CHUNK_OK : CMDPROT_CHUNK_NAK;
+}
+
+u08 getStreamNaks(void) {
+  return streamNaks;
 }
 
 /************************************************************************
@@ -247,13 +602,24 @@ inline u08 isGlobalAddress(u08 inAddr) {
  ************************************************************************/
 void myUartRx(unsigned char c) {
   
+  rxByteCount++;
   if (!rxAddrNext) { // if non-address byte (typical)
     // first, scan the char received for special trigger values.
     switch (c) {
       case 0x24: // '$' command terminator byte (not included in cmd buffer!)
+        rxStreaming = FALSE; // end of any stream data
         if (rxAddressed) { // only take action if we were addressed
-          // indicate that a cmd is fully received to initiate command processing
-          rxCompleteFlag = TRUE; // allow mainline to process cmd now.
+          if (rxCmdOk) {
+            // fill in the header, then it's whole up to here
+            uartRxBuffer.dataptr[rxCmdStart & uartRxBuffer.mask] =
+              (u08)(uartRxBuffer.head - rxCmdStart - 1) | (rxCmdGlobal ? CMDPROT_HDR_GLOBAL : 0);
+            RBUFFER_BARRIER();
+            rxCmdEnd = uartRxBuffer.head;
+            // indicate that a cmd is fully received to initiate command processing
+            rxCompleteFlag = TRUE; // allow mainline to process cmd now.
+          } else {
+            uartRxBuffer.head = rxCmdEnd; // it didn't fit, drop it rather than run half of it
+          }
           rxAddressed = FALSE; // stop accumulating bytes into cmd buffer.
           PORTD &= ~(1 << PIND5); // DEBUG TURN OFF LED INDICATOR
         }
@@ -267,29 +633,129 @@ void myUartRx(unsigned char c) {
         break;
     }
     if (rxAddressed) {
-      // put received char in buffer, check if there's space
-      if( !bufferAddToEnd(&uartRxBuffer, c) ) { // for now, use the built-in UART RX buffer to collect the cmd.
-        // no space in buffer, count overflow
-        uartRxOverflow++;
+      if (rxStreaming) {
+        // stream data goes straight to the target buffer
+        streamRxNibble(c);
+      } else {
+        // put received char in buffer, check if there's space
+        if( !rBufferPut(&uartRxBuffer, c) ) { // for now, use the built-in UART RX buffer to collect the cmd.
+          // no space in buffer, count overflow
+          uartRxOverflow++;
+          rxCmdOk = FALSE;
+        }
+        // 'f' or 'c' as the first byte of a cmd (after the header): the rest of it is stream data
+        if ((((c | 0x20) == 'f') || ((c | 0x20) == 'c')) && ((u08)(uartRxBuffer.head - rxCmdStart) == 2)) {
+          rxStreaming = TRUE;
+          rxStreamsBegun++;
+          rxStreamChecked = ((c | 0x20) == 'c');
+          rxStreamHdr = CMDPROT_CHUNK_NAKHDR; // until it's all in and checked
+          rxStreamNibbles = 0;
+          rxStreamHigh = 0xFF;
+          rxStreamSeq = 0;
+          rxStreamStart = 0;
+          rxStreamLen = 0;
+          rxStreamCount = 0;
+          rxStreamError = FALSE;
+          rxStreamCrc = _crc_ccitt_update(0xFFFF, c);
+          rxStreamCrcIn = 0;
+          rxStreamCrcNibbles = 0;
+        }
       }
     } // end rxAddressed
   } // end processing for non-address byte
   else { // if this byte IS an address byte
     rxAddrNext = FALSE; // only one addr byte per cmd, so next one won't be.
-    if (isMyAddress(c)) {
+    rxStreaming = FALSE; // a new cmd ends any stream
+    rxStreamChecked = FALSE; // and a 'c' that isn't one has nothing to check
+    if (isMyAddress(c) || isGlobalAddress(c)) {
       PORTD |= (1 << PIND5); // DEBUG TURN ON BLUE LED INDICATOR
-      if (rxCommandProcessing) { // if we're already doing something, clear out buffer and record an error condition
-        rxCommandOverloaded = TRUE; // not used right now, but could be used to indicate overflow condition
-        flg_forceGlobalCmdResponse = FALSE;
-        rxAddrGlobal = TRUE; // these two statements will prevent any output from endCmdProc.
-        endCmdProcessing(); // reset all state from previous cmd.
+      // drop what came of a cmd that never got its '$'. Only whole cmds
+      // are before rxCmdEnd, and head is ours to move back.
+      uartRxBuffer.head = rxCmdEnd;
+      rxCmdStart = rxCmdEnd;
+      rxCmdGlobal = isGlobalAddress(c); // mute any response on global cmds
+      rxCmdOk = rBufferPut(&uartRxBuffer, 0); // room for the header, filled in at the '$'
+      if (!rxCmdOk) {
+        uartRxOverflow++;
       }
       rxAddressed = TRUE; // this unit is now active and will record bytes
     }
-    if (isGlobalAddress(c)) {
-      PORTD |= (1 << PIND5); // DEBUG TURN ON BLUE LED INDICATOR
-      rxAddrGlobal = TRUE; // mute any response on global cmds
-      rxAddressed = TRUE; // this unit is now active and will record bytes 
+    if (isMyAddress(c) && rxCommandProcessing) { // if we're already doing something, record it
+      // not used right now, but could be used to indicate overflow condition.
+      // The new cmd queues up behind the one in progress and gets processed next.
+      rxCommandOverloaded = TRUE;
+    }
+  }
+}
+
+/************************************************************************
+ * streamRxNibble:
+ * 
+ * Decode one byte of an 'f' or 'c' command (see commandprotocol.h).
+ * Called from the rx ISR, so keep it short.
+ ************************************************************************/
+void streamRxNibble(unsigned char c) {
+  u08 hdr = rxStreamChecked ? CMDPROT_CHUNK_HDR : CMDPROT_STREAM_HDR;
+
+  if ((c & 0xF0) != 0x30) { // not a nibble, stream is corrupt
+    rxStreamError = TRUE;
+    return;
+  }
+  if (rxStreamChecked) {
+    if ((rxStreamNibbles == hdr) && (rxStreamCount == rxStreamLen) && (rxStreamHigh == 0xFF)) {
+      // all the data is in, this is the CRC
+      if (rxStreamCrcNibbles < 4) {
+        rxStreamCrcIn = (rxStreamCrcIn << 4) | (c & 0x0F);
+        rxStreamCrcNibbles++;
+      } else {
+        rxStreamError = TRUE;
+      }
+      return;
+    }
+    if (rxStreamNibbles < CMDPROT_CHUNK_FIELDS) {
+      rxStreamCrc = _crc_ccitt_update(rxStreamCrc, c); // the header, see streamDataCrc()
+    }
+  }
+  c &= 0x0F;
+  
+  if (rxStreamNibbles < hdr) { // header: target, [seq,] offset[, length, CRC]
+    if (rxStreamNibbles == 0) {
+      rxStreamTarget = c;
+    } else if (rxStreamChecked && (rxStreamNibbles < 3)) {
+      rxStreamSeq = (rxStreamSeq << 4) | c;
+    } else if (rxStreamNibbles < (rxStreamChecked ? 7 : CMDPROT_STREAM_HDR)) {
+      rxStreamStart = (rxStreamStart << 4) | c;
+    } else if (rxStreamNibbles < CMDPROT_CHUNK_FIELDS) {
+      rxStreamLen = (rxStreamLen << 4) | c;
+    } else {
+      rxStreamCrcIn = (rxStreamCrcIn << 4) | c;
+    }
+    if (++rxStreamNibbles == hdr) { // header done, point at the target
+      if (rxStreamChecked && (rxStreamCrcIn != rxStreamCrc)) {
+        // any of it could be wrong, the offset too
+        rxStreamError = TRUE;
+        rxStreamPtr = rxStreamEnd = 0; // no writes
+      } else if ((rxStreamTarget >= CMDPROT_STREAM_TARGETS) || (rxStreamStart >= streamSize[rxStreamTarget])
+          || (rxStreamLen > streamSize[rxStreamTarget] - rxStreamStart)) {
+        rxStreamError = TRUE;
+        rxStreamHdr = CMDPROT_CHUNK_RANGE;
+        rxStreamPtr = rxStreamEnd = 0; // no writes
+      } else {
+        rxStreamHdr = CMDPROT_CHUNK_OK;
+        rxStreamPtr = streamBuf[rxStreamTarget] + rxStreamStart;
+        rxStreamEnd = streamBuf[rxStreamTarget] + streamSize[rxStreamTarget];
+      }
+      rxStreamCrcIn = 0; // the chunk's comes at the end
+    }
+  } else if (rxStreamHigh == 0xFF) { // first nibble of a data byte
+    rxStreamHigh = c << 4;
+  } else { // second nibble, store the byte
+    if (rxStreamPtr < rxStreamEnd) {
+      *rxStreamPtr++ = rxStreamHigh | c;
+      rxStreamCount++;
+    } else {
+      rxStreamError = TRUE; // ran off the end of the target
     }
+    rxStreamHigh = 0xFF;
   }
 }
@@ -25,11 +25,51 @@
   - no data byte can be mistaken as the END_CMD byte (0x24)
  Use case: Might need to use binary data for a passthrough device to relay command
   data to a projector serial input.
+
+ Binary streaming ('f' command), implemented with the nibble idea above:
+   '!' addr 'f' t o o o o (h l)* '$'
+   t    = target buffer, one nibble (0x30 + n), see setCommandProtocolStreamBuffer()
+   oooo = byte offset into the target buffer, 4 nibbles, high nibble first
+   h l  = each data byte as two nibbles, high nibble first
+  The rx ISR decodes the data straight into the target buffer, it never
+  goes through uartRxBuffer. Only the 'f' lands in the command buffer, so
+  processCmd sees a one letter command and can ask for the details with
+  getStream*(). Anything other than 0x3n in the stream, or writing past
+  the end of the target, sets the stream error flag.
+
+ Checked binary frames ('c' command), the same with a sequence number,
+ a length and CRCs, for big uploads at high baud rates:
+   '!' addr 'c' t s s o o o o n n n n k k k k (h l)* r r r r '$'
+   t, oooo, h l = as for 'f'
+   ss   = sequence number of the chunk, 2 nibbles
+   nnnn = number of data bytes, 4 nibbles
+   kkkk = CRC-16 CCITT (_crc_ccitt_update, start 0xFFFF) of the header,
+          every byte from the 'c' to the last length nibble
+   rrrr = the same CRC carried on over the data, every byte from the 'c'
+          to the last data nibble but without kkkk
+  The rx ISR works out the header's CRC as it comes in. Nothing is
+  written before kkkk has checked out, so a chunk with a bad offset
+  can't land on top of one that's already in. The data's CRC is worked
+  out from the target buffer when the chunk is checked, to keep the ISR
+  short (it runs between LED output chunks), so nothing may write there
+  before that.
+  The slave answers each chunk with
+   "c<seq>$"  it checked out
+   "n<seq>$"  its data didn't, send just that chunk again
+   "n$"       its header didn't, nothing was written and the seq can't be
+              trusted. Send again the chunks that have no answer yet
+  A chunk that got no answer at all has to be sent again too, it may
+  have been the '!' that got lost. A bad chunk's data is in the target
+  buffer until it's sent again, so the application shouldn't show
+  anything while there are chunks NAKed and not yet resent
+  (getStreamNaks()). Chunk 0 starts a new upload and forgets the NAKs of
+  the last one.
  *********************************************************************/
 #ifndef COMMANDPROTOCOL_H
 #define COMMANDPROTOCOL_H
 
-#include "bufferchris.h"
+#include <avr/pgmspace.h>
+#include "ringbuffer.h"
 #include "uartchris.h"
 
 #define CMDPROT_MY_ADDRESS	0x31 // ASCII "1"
@@ -52,15 +92,123 @@ u08 getCommandProtocolAddr(void);
 u08 setCommandProtocolAddr(u08);
 
 u08 isCommandReady(void);
+u08 isCommandReceiving(void);
+u08 isStreamReceiving(void);
 void beginCmdProcessing(void);
 void endCmdProcessing(void);
-// used by command processors, advances the pointer over ASCII numbers. pass the [address] of your char ptr
-void pointToNextNonNumericChar(unsigned char **);
-// this gets called by endCmdProc() but you can also call it to send (and clear) a message in cmdprotprintbuf
+// Reading the cmd between begin- and endCmdProcessing(). It stays in the
+// uart rx ring where it came in, the next cmd can be coming in behind it.
+// There's no NUL at its end, these return 0 there instead.
+// TRUE while there's more of the cmd
+u08 cmdMore(void);
+// the next byte, and move over it
+char cmdGetChar(void);
+// the next byte, and stay on it
+char cmdPeekChar(void);
+// a decimal number, and move over its digits. 0 if there are none,
+// 0xFFFFFFFF if it's bigger than that
+u32 cmdGetNum(void);
+// the rest of the cmd, NUL terminated and cut to fit size bytes. Returns
+// the length copied
+u08 cmdGetString(char *s, u08 size);
+// Building the reply. It goes straight into the uart tx ring, behind
+// anything still going out, but isn't sent until sendMsg(). Replies are
+// cut at UART_TX_BUFFER_SIZE-1 bytes, so the '$' always fits.
+// start a new reply, dropping anything already put
+void rspBegin(void);
+void rspChar(char c);
+// a NUL terminated string, in RAM or in pgm mem
+void rspStr(const char *s);
+void rspStr_P(PGM_P s);
+// decimal, no leading zeros
+void rspDec(u32 n);
+// decimal, then sep: rspField(a, ','); rspField(b, '$'); gives "a,b$"
+void rspField(u32 n, char sep);
+// two lower case hex digits
+void rspHex(u08 b);
+// this gets called by endCmdProc() but you can also call it to send (and clear) the reply.
+// It's "k" if nothing was put, and gets a '$' on the end if it hasn't one.
 void sendMsg(void);
 // call this to force sendMsg to send a response even if the received address was global (0)
 void forceGlobalCmdResponse(void);
 
+/*********************************************************************
+ * Command tables. The application lists its cmd letters in a table in
+ * pgm mem, each with the argument it takes and its handler, and
+ * registers it with cmdTableInit() at init. That fills in a letter ->
+ * entry index in RAM, 26 bytes however many cmds there are, so cmdRun()
+ * finds a letter's handler in one step. Letters match in either case.
+ *
+ * A CMDARG_NUM argument is read and range checked before the handler
+ * gets it, a bigger number gets the entry's err reply and the handler
+ * isn't called. A handler can run a table of its own for a second
+ * letter, as 'g' does for the property to get.
+ *
+ * Example:
+ *   const char errBadLevel[] PROGMEM = "err-badlevel";
+ *   const char errCmd[] PROGMEM = "err-cmd$";
+ *   const cmdEntry myCmds[] PROGMEM = {
+ *     { 'L', CMDARG_NUM, 255, errBadLevel, handleLevel }, // handleLevel(u32 n)
+ *   };
+ *   cmdTable myTable;
+ *   cmdTableInit(&myTable, myCmds, sizeof(myCmds)/sizeof(myCmds[0]), errCmd);
+ *   ...
+ *   while (cmdMore()) {
+ *     cmdRun(&myTable);
+ *   }
+ *********************************************************************/
+#define CMDARG_NONE     0 // the handler gets 0
+#define CMDARG_NUM      1 // a decimal number, up to max
+#define CMDARG_REST     2 // the handler reads the rest of the cmd itself, gets 0
+
+typedef void (*cmdHandler)(u32 n);
+
+typedef struct {
+  char op;              // cmd letter
+  u08 arg;              // CMDARG_*
+  u32 max;              // CMDARG_NUM: biggest number taken
+  PGM_P err;            // reply to a bigger one, in pgm mem. NULL for none
+  cmdHandler handler;
+} cmdEntry;
+
+typedef struct {
+  const cmdEntry *entries; // in pgm mem
+  PGM_P unknown;           // reply to a letter that isn't in the table
+  u08 index[26];           // entry+1 for each letter, 0 = none
+} cmdTable;
+
+void cmdTableInit(cmdTable *t, const cmdEntry *entries, u08 count, PGM_P unknown);
+// take the next letter of the cmd, and its argument, and run its handler
+void cmdRun(const cmdTable *t);
+
+// number of buffers the 'f' command can stream into
+#define CMDPROT_STREAM_TARGETS  2
+// register a buffer the 'f' command can stream into, as target 0..CMDPROT_STREAM_TARGETS-1
+void setCommandProtocolStreamBuffer(u08 target, u08 *buf, u16 size);
+// details of the last 'f' command, for use while processing it
+u08 getStreamTarget(void);
+u16 getStreamStart(void);
+u16 getStreamLength(void);
+u08 getStreamError(void);
+// 'c' chunks: its sequence number, and what came of it. Call
+// checkStreamChunk() once per chunk, it keeps the NAK count
+#define CMDPROT_CHUNK_OK        0 // it all checked out
+#define CMDPROT_CHUNK_NAK       1 // the data didn't
+#define CMDPROT_CHUNK_NAKHDR    2 // the header didn't, nothing was written
+#define CMDPROT_CHUNK_RANGE     3 // the header checked out, but doesn't fit the target
+u08 getStreamSeq(void);
+u08 checkStreamChunk(void);
+// chunks NAKed and not sent again yet
+u08 getStreamNaks(void);
+// streams ('f' or 'c') for us begun so far, wraps. The rx ISR writes
+// their data into the target as it comes, whatever the application is
+// doing with it: compare before and after using a target to see if
+// one came in meanwhile
+u08 getStreamsBegun(void);
+// the stream coming in or being processed is bad after all, eg. it was
+// written over. 'f' gets the stream error, 'c' a NAK
+void setStreamError(void);
+
 
 /*********************************************************************
  * Use these flags to control your application's behavior. They will tell
@@ -74,12 +222,14 @@ extern volatile u08 rxAddrNext; // indicate that the next byte rx will be an add
 extern volatile u08 rxAddressed; // indicate whether this unit was addressed by master
 extern volatile u08 rxAddrGlobal; // Do Not Transmit if global address was found
 extern volatile u08 rxCommandProcessing; // command processing latch (started, not complete)
+extern volatile u08 rxByteCount; // bytes seen by the rx ISR, wraps. To tell if the line is busy
 
 
 // the following vars are used to interact with uart receive ISR
-extern cBuffer uartRxBuffer;	// defined in uartchris.c
+extern rBuffer uartRxBuffer;	// defined in uartchris.c
 extern unsigned short uartRxOverflow; // defined in uartchris.c
-extern char cmdprotprintbuf[80]; // output message buffer
+extern unsigned short uartRxFrameErrors; // defined in uartchris.c
+extern unsigned short uartRxOverruns; // defined in uartchris.c
 
 #endif
 
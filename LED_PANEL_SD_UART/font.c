@@ -0,0 +1,261 @@
+/*
+ * font.c
+ *
+ * See font.h for details
+ *
+ */
+
+#include <string.h>
+#include <avr/io.h>
+#include <avr/pgmspace.h>
+#include "global.h"
+#include "WS2812.h"
+#include "font.h"
+
+// classic 5x7, ASCII 32..126
+const u08 font5x7Cols[] PROGMEM = {
+	0x00, 0x00, 0x00, 0x00, 0x00, // space
+	0x00, 0x00, 0x5f, 0x00, 0x00, // !
+	0x00, 0x07, 0x00, 0x07, 0x00, // "
+	0x14, 0x7f, 0x14, 0x7f, 0x14, // #
+	0x24, 0x2a, 0x7f, 0x2a, 0x12, // $
+	0x23, 0x13, 0x08, 0x64, 0x62, // %
+	0x36, 0x49, 0x55, 0x22, 0x50, // &
+	0x00, 0x05, 0x03, 0x00, 0x00, // '
+	0x00, 0x1c, 0x22, 0x41, 0x00, // (
+	0x00, 0x41, 0x22, 0x1c, 0x00, // )
+	0x08, 0x2a, 0x1c, 0x2a, 0x08, // *
+	0x08, 0x08, 0x3e, 0x08, 0x08, // +
+	0x00, 0x50, 0x30, 0x00, 0x00, // ,
+	0x08, 0x08, 0x08, 0x08, 0x08, // -
+	0x00, 0x60, 0x60, 0x00, 0x00, // .
+	0x20, 0x10, 0x08, 0x04, 0x02, // /
+	0x3e, 0x51, 0x49, 0x45, 0x3e, // 0
+	0x00, 0x42, 0x7f, 0x40, 0x00, // 1
+	0x42, 0x61, 0x51, 0x49, 0x46, // 2
+	0x21, 0x41, 0x45, 0x4b, 0x31, // 3
+	0x18, 0x14, 0x12, 0x7f, 0x10, // 4
+	0x27, 0x45, 0x45, 0x45, 0x39, // 5
+	0x3c, 0x4a, 0x49, 0x49, 0x30, // 6
+	0x01, 0x71, 0x09, 0x05, 0x03, // 7
+	0x36, 0x49, 0x49, 0x49, 0x36, // 8
+	0x06, 0x49, 0x49, 0x29, 0x1e, // 9
+	0x00, 0x36, 0x36, 0x00, 0x00, // :
+	0x00, 0x56, 0x36, 0x00, 0x00, // ;
+	0x08, 0x14, 0x22, 0x41, 0x00, // <
+	0x14, 0x14, 0x14, 0x14, 0x14, // =
+	0x00, 0x41, 0x22, 0x14, 0x08, // >
+	0x02, 0x01, 0x51, 0x09, 0x06, // ?
+	0x32, 0x49, 0x79, 0x41, 0x3e, // @
+	0x7e, 0x11, 0x11, 0x11, 0x7e, // A
+	0x7f, 0x49, 0x49, 0x49, 0x36, // B
+	0x3e, 0x41, 0x41, 0x41, 0x22, // C
+	0x7f, 0x41, 0x41, 0x22, 0x1c, // D
+	0x7f, 0x49, 0x49, 0x49, 0x41, // E
+	0x7f, 0x09, 0x09, 0x09, 0x01, // F
+	0x3e, 0x41, 0x49, 0x49, 0x7a, // G
+	0x7f, 0x08, 0x08, 0x08, 0x7f, // H
+	0x00, 0x41, 0x7f, 0x41, 0x00, // I
+	0x20, 0x40, 0x41, 0x3f, 0x01, // J
+	0x7f, 0x08, 0x14, 0x22, 0x41, // K
+	0x7f, 0x40, 0x40, 0x40, 0x40, // L
+	0x7f, 0x02, 0x0c, 0x02, 0x7f, // M
+	0x7f, 0x04, 0x08, 0x10, 0x7f, // N
+	0x3e, 0x41, 0x41, 0x41, 0x3e, // O
+	0x7f, 0x09, 0x09, 0x09, 0x06, // P
+	0x3e, 0x41, 0x51, 0x21, 0x5e, // Q
+	0x7f, 0x09, 0x19, 0x29, 0x46, // R
+	0x46, 0x49, 0x49, 0x49, 0x31, // S
+	0x01, 0x01, 0x7f, 0x01, 0x01, // T
+	0x3f, 0x40, 0x40, 0x40, 0x3f, // U
+	0x1f, 0x20, 0x40, 0x20, 0x1f, // V
+	0x3f, 0x40, 0x38, 0x40, 0x3f, // W
+	0x63, 0x14, 0x08, 0x14, 0x63, // X
+	0x07, 0x08, 0x70, 0x08, 0x07, // Y
+	0x61, 0x51, 0x49, 0x45, 0x43, // Z
+	0x00, 0x7f, 0x41, 0x41, 0x00, // [
+	0x02, 0x04, 0x08, 0x10, 0x20, // backslash
+	0x00, 0x41, 0x41, 0x7f, 0x00, // ]
+	0x04, 0x02, 0x01, 0x02, 0x04, // ^
+	0x40, 0x40, 0x40, 0x40, 0x40, // _
+	0x00, 0x01, 0x02, 0x04, 0x00, // `
+	0x20, 0x54, 0x54, 0x54, 0x78, // a
+	0x7f, 0x48, 0x44, 0x44, 0x38, // b
+	0x38, 0x44, 0x44, 0x44, 0x20, // c
+	0x38, 0x44, 0x44, 0x48, 0x7f, // d
+	0x38, 0x54, 0x54, 0x54, 0x18, // e
+	0x08, 0x7e, 0x09, 0x01, 0x02, // f
+	0x0c, 0x52, 0x52, 0x52, 0x3e, // g
+	0x7f, 0x08, 0x04, 0x04, 0x78, // h
+	0x00, 0x44, 0x7d, 0x40, 0x00, // i
+	0x20, 0x40, 0x44, 0x3d, 0x00, // j
+	0x7f, 0x10, 0x28, 0x44, 0x00, // k
+	0x00, 0x41, 0x7f, 0x40, 0x00, // l
+	0x7c, 0x04, 0x18, 0x04, 0x78, // m
+	0x7c, 0x08, 0x04, 0x04, 0x78, // n
+	0x38, 0x44, 0x44, 0x44, 0x38, // o
+	0x7c, 0x14, 0x14, 0x14, 0x08, // p
+	0x08, 0x14, 0x14, 0x18, 0x7c, // q
+	0x7c, 0x08, 0x04, 0x04, 0x08, // r
+	0x48, 0x54, 0x54, 0x54, 0x20, // s
+	0x04, 0x3f, 0x44, 0x40, 0x20, // t
+	0x3c, 0x40, 0x40, 0x20, 0x7c, // u
+	0x1c, 0x20, 0x40, 0x20, 0x1c, // v
+	0x3c, 0x40, 0x30, 0x40, 0x3c, // w
+	0x44, 0x28, 0x10, 0x28, 0x44, // x
+	0x0c, 0x50, 0x50, 0x50, 0x3c, // y
+	0x44, 0x64, 0x54, 0x4c, 0x44, // z
+	0x00, 0x08, 0x36, 0x41, 0x00, // {
+	0x00, 0x00, 0x7f, 0x00, 0x00, // |
+	0x00, 0x41, 0x36, 0x08, 0x00, // }
+	0x08, 0x04, 0x08, 0x10, 0x08, // ~
+};
+
+// 3x5, ASCII 32..126, lower case looks like upper case
+const u08 font3x5Cols[] PROGMEM = {
+	0x00, 0x00, 0x00, // space
+	0x00, 0x17, 0x00, // !
+	0x03, 0x00, 0x03, // "
+	0x1f, 0x0a, 0x1f, // #
+	0x12, 0x1f, 0x09, // $
+	0x19, 0x04, 0x13, // %
+	0x0a, 0x15, 0x1a, // &
+	0x00, 0x03, 0x00, // '
+	0x00, 0x0e, 0x11, // (
+	0x11, 0x0e, 0x00, // )
+	0x0a, 0x04, 0x0a, // *
+	0x04, 0x0e, 0x04, // +
+	0x10, 0x08, 0x00, // ,
+	0x04, 0x04, 0x04, // -
+	0x00, 0x10, 0x00, // .
+	0x18, 0x04, 0x03, // /
+	0x1f, 0x11, 0x1f, // 0
+	0x12, 0x1f, 0x10, // 1
+	0x1d, 0x15, 0x17, // 2
+	0x11, 0x15, 0x1f, // 3
+	0x07, 0x04, 0x1f, // 4
+	0x17, 0x15, 0x1d, // 5
+	0x1f, 0x15, 0x1d, // 6
+	0x01, 0x1d, 0x03, // 7
+	0x1f, 0x15, 0x1f, // 8
+	0x17, 0x15, 0x1f, // 9
+	0x00, 0x0a, 0x00, // :
+	0x10, 0x0a, 0x00, // ;
+	0x04, 0x0a, 0x11, // <
+	0x0a, 0x0a, 0x0a, // =
+	0x11, 0x0a, 0x04, // >
+	0x01, 0x15, 0x07, // ?
+	0x1f, 0x15, 0x17, // @
+	0x1e, 0x05, 0x1e, // A
+	0x1f, 0x15, 0x0a, // B
+	0x0e, 0x11, 0x11, // C
+	0x1f, 0x11, 0x0e, // D
+	0x1f, 0x15, 0x11, // E
+	0x1f, 0x05, 0x01, // F
+	0x0e, 0x11, 0x1d, // G
+	0x1f, 0x04, 0x1f, // H
+	0x11, 0x1f, 0x11, // I
+	0x08, 0x10, 0x0f, // J
+	0x1f, 0x04, 0x1b, // K
+	0x1f, 0x10, 0x10, // L
+	0x1f, 0x06, 0x1f, // M
+	0x1f, 0x01, 0x1e, // N
+	0x0e, 0x11, 0x0e, // O
+	0x1f, 0x05, 0x02, // P
+	0x0e, 0x19, 0x16, // Q
+	0x1f, 0x05, 0x1a, // R
+	0x12, 0x15, 0x09, // S
+	0x01, 0x1f, 0x01, // T
+	0x1f, 0x10, 0x1f, // U
+	0x0f, 0x10, 0x0f, // V
+	0x1f, 0x0c, 0x1f, // W
+	0x1b, 0x04, 0x1b, // X
+	0x03, 0x1c, 0x03, // Y
+	0x19, 0x15, 0x13, // Z
+	0x1f, 0x11, 0x00, // [
+	0x03, 0x04, 0x18, // backslash
+	0x00, 0x11, 0x1f, // ]
+	0x02, 0x01, 0x02, // ^
+	0x10, 0x10, 0x10, // _
+	0x01, 0x02, 0x00, // `
+	0x1e, 0x05, 0x1e, // a
+	0x1f, 0x15, 0x0a, // b
+	0x0e, 0x11, 0x11, // c
+	0x1f, 0x11, 0x0e, // d
+	0x1f, 0x15, 0x11, // e
+	0x1f, 0x05, 0x01, // f
+	0x0e, 0x11, 0x1d, // g
+	0x1f, 0x04, 0x1f, // h
+	0x11, 0x1f, 0x11, // i
+	0x08, 0x10, 0x0f, // j
+	0x1f, 0x04, 0x1b, // k
+	0x1f, 0x10, 0x10, // l
+	0x1f, 0x06, 0x1f, // m
+	0x1f, 0x01, 0x1e, // n
+	0x0e, 0x11, 0x0e, // o
+	0x1f, 0x05, 0x02, // p
+	0x0e, 0x19, 0x16, // q
+	0x1f, 0x05, 0x1a, // r
+	0x12, 0x15, 0x09, // s
+	0x01, 0x1f, 0x01, // t
+	0x1f, 0x10, 0x1f, // u
+	0x0f, 0x10, 0x0f, // v
+	0x1f, 0x0c, 0x1f, // w
+	0x1b, 0x04, 0x1b, // x
+	0x03, 0x1c, 0x03, // y
+	0x19, 0x15, 0x13, // z
+	0x04, 0x1b, 0x11, // {
+	0x00, 0x1f, 0x00, // |
+	0x11, 0x1b, 0x04, // }
+	0x04, 0x06, 0x02, // ~
+};
+
+const font font5x7 = { font5x7Cols, 5, 7, 32, 126 };
+const font font3x5 = { font3x5Cols, 3, 5, 32, 126 };
+
+u16 fontTextWidth(const font *f, const char *s) {
+  return strlen(s) * (f->width + 1);
+}
+
+u08 fontTextColumn(const font *f, const char *s, u16 col) {
+  u08 c;
+
+  while (col > f->width) { // skip whole glyphs
+    if (!*s++) {
+      return 0;
+    }
+    col -= f->width + 1;
+  }
+  c = *s;
+  if ((col == f->width) || (c < f->first) || (c > f->last)) {
+    return 0; // the blank column, end of text or no glyph
+  }
+  return pgm_read_byte(&f->cols[(u16)(c - f->first) * f->width + col]);
+}
+
+void fontDrawColumn(u08 *p_buf, u16 first_led, u16 leds, const textStyle *st,
+                    u08 bits, u08 x, s16 y) {
+  u08 row;
+  const u08 *rgb;
+
+  for (row = 0; row < st->f->height; row++, bits >>= 1) {
+    if ((y - row < 0) || (y - row >= 2*YBOUND)) {
+      continue;
+    }
+    rgb = (bits & 1) ? st->fg : st->bg;
+    set_color_xy_in(p_buf, first_led, leds, x, y - row, rgb[0], rgb[1], rgb[2]);
+  }
+}
+
+void fontDrawText(u08 *p_buf, u16 first_led, u16 leds, const textStyle *st,
+                  const char *s, s16 x, s16 y) {
+  u08 px, bits;
+
+  for (px = 0; px < XBOUND; px++) {
+    bits = 0; // background left of the text
+    if (px >= x) {
+      bits = fontTextColumn(st->f, s, px - x); // one flash read
+    }
+    fontDrawColumn(p_buf, first_led, leds, st, bits, px, y);
+  }
+}
@@ -0,0 +1,62 @@
+/*********************************************************************
+ *
+ * Bitmap fonts and text
+ *
+ * Fonts are in pgm mem, one byte per glyph column, bit 0 the top row, so
+ * a column of text costs one flash read. Glyphs are drawn with one blank
+ * column after each.
+ *
+ * Text goes into a GRB buffer through the pixel map, like set_color_xy.
+ * (x, y) is the text's top left pixel, with y = 0 the bottom row of the
+ * panel (the way the pictures are stored) so the text runs down to lower
+ * y. Anything off the panel or outside the buffer is clipped, so x can
+ * be negative to scroll text out to the left. The whole line is drawn,
+ * across the panel, with the background where there's no text, and only
+ * the pixels that change are marked dirty (see mark_dirty in WS2812.h):
+ * new text over old only sends what differs.
+ *
+ * The buffer can be the whole panel, or with half a panel of buffer the
+ * one string it holds:
+ *
+ * Example:
+ *   textStyle st = { &font5x7, {255, 255, 0}, {0, 0, 0} }; // yellow on black
+ *   fontDrawText(buf, 0, PANEL_PIXELS, &st, "Hello", 0, 2*YBOUND-1);
+ *   // or one string at a time:
+ *   fontDrawText(buf, NUM_WS2812, NUM_WS2812, &st, "Hello", -3, 14);
+ *********************************************************************/
+#ifndef FONT_H
+#define FONT_H
+
+#include "global.h"
+
+typedef struct {
+  const u08 *cols;  // glyph columns in pgm mem, width bytes per glyph
+  u08 width;        // columns per glyph, without the blank one
+  u08 height;       // rows, up to 8
+  u08 first;        // characters first..last have glyphs, others are blank
+  u08 last;
+} font;
+
+typedef struct {
+  const font *f;
+  u08 fg[3];        // text color, R G B
+  u08 bg[3];        // background color
+} textStyle;
+
+extern const font font5x7;
+extern const font font3x5;
+
+// columns the text takes, blank ones included
+u16 fontTextWidth(const font *f, const char *s);
+// the glyph bits of column col of the text, 0 past its end
+u08 fontTextColumn(const font *f, const char *s, u16 col);
+// draw one column of glyph bits (fontTextColumn) at panel column x, from
+// row y down, into p_buf as below
+void fontDrawColumn(u08 *p_buf, u16 first_led, u16 leds, const textStyle *st,
+                    u08 bits, u08 x, s16 y);
+// draw s with its top left pixel at x, y into p_buf, which holds
+// leds LEDs from first_led on
+void fontDrawText(u08 *p_buf, u16 first_led, u16 leds, const textStyle *st,
+                  const char *s, s16 x, s16 y);
+
+#endif
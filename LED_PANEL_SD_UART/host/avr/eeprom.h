@@ -0,0 +1,14 @@
+/*********************************************************************
+ * Host build stand-in for <avr/eeprom.h>. The EEPROM is an array in
+ * hostpanel.c, erased (0xFF) at start up.
+ *********************************************************************/
+
+#ifndef HOST_AVR_EEPROM_H
+#define HOST_AVR_EEPROM_H
+
+#include <stdint.h>
+
+uint8_t eeprom_read_byte(const uint8_t *addr);
+void eeprom_write_byte(uint8_t *addr, uint8_t value);
+
+#endif
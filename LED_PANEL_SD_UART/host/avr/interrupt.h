@@ -0,0 +1,21 @@
+/*********************************************************************
+ * Host build stand-in for <avr/interrupt.h>.
+ *
+ * An ISR is a plain function named after its vector, hostpanel.c calls
+ * the ones it emulates.
+ *********************************************************************/
+
+#ifndef HOST_AVR_INTERRUPT_H
+#define HOST_AVR_INTERRUPT_H
+
+#include <avr/io.h>
+
+#define ISR(vector)     void vector(void); void vector(void)
+#define SIGNAL(vector)  ISR(vector)
+
+void USART_RX_vect(void);
+void USART_TX_vect(void);
+void USART_UDRE_vect(void);
+void TIMER1_COMPA_vect(void);
+
+#endif
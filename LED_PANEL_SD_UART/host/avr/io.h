@@ -0,0 +1,98 @@
+/*********************************************************************
+ * Host build stand-in for <avr/io.h>, ATmega328P registers only.
+ *
+ * Registers are plain variables in hostpanel.c. UDR0 and TCNT1 go
+ * through functions, so the emulated uart knows when a byte is written
+ * to it, and the timer can count.
+ *********************************************************************/
+
+#ifndef HOST_AVR_IO_H
+#define HOST_AVR_IO_H
+
+#include <stdint.h>
+
+#ifndef __AVR_ATmega328P__
+#define __AVR_ATmega328P__ 1
+#endif
+
+extern volatile uint8_t PORTD, DDRD, PIND, PORTC, DDRC, PINC, PORTB, DDRB, PINB;
+extern volatile uint8_t SREG;
+extern volatile uint8_t UCSR0A, UCSR0B, UCSR0C, UBRR0L, UBRR0H;
+extern volatile uint8_t TCCR1A, TCCR1B, TIMSK1, TIFR1;
+extern volatile uint16_t OCR1A;
+
+volatile uint8_t *hostUdr(void);
+#define UDR0    (*hostUdr())
+// Timer1 follows the host's clock, as if it ran at F_CPU
+volatile uint16_t *hostTcnt1(void);
+#define TCNT1   (*hostTcnt1())
+
+#define RAMEND  0x8FF
+#define E2END   0x3FF
+
+// interrupts are the I bit in SREG, hostpanel.c runs the ISRs from a
+// timer signal whenever it is set
+#define cli()   (SREG &= ~0x80)
+#define sei()   (SREG |= 0x80)
+
+// port D
+#define PD0 0
+#define PD1 1
+#define PD2 2
+#define PD3 3
+#define PD4 4
+#define PD5 5
+#define PD6 6
+#define PD7 7
+#define PIND0 0
+#define PIND1 1
+#define PIND2 2
+#define PIND3 3
+#define PIND4 4
+#define PIND5 5
+#define PIND6 6
+#define PIND7 7
+#define DDD0 0
+#define DDD1 1
+#define DDD2 2
+#define DDD3 3
+#define DDD4 4
+#define DDD5 5
+#define DDD6 6
+#define DDD7 7
+
+// USART0
+#define MPCM0   0
+#define U2X0    1
+#define UPE0    2
+#define DOR0    3
+#define FE0     4
+#define UDRE0   5
+#define TXC0    6
+#define RXC0    7
+#define TXB80   0
+#define RXB80   1
+#define UCSZ02  2
+#define TXEN0   3
+#define RXEN0   4
+#define UDRIE0  5
+#define TXCIE0  6
+#define RXCIE0  7
+#define UCSZ00  1
+#define UCSZ01  2
+
+// timer 1
+#define WGM10   0
+#define WGM11   1
+#define CS10    0
+#define CS11    1
+#define CS12    2
+#define WGM12   3
+#define WGM13   4
+#define TOIE1   0
+#define OCIE1A  1
+#define OCIE1B  2
+#define TOV1    0
+#define OCF1A   1
+
+#endif
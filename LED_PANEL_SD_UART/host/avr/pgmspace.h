@@ -0,0 +1,27 @@
+/*********************************************************************
+ * Host build stand-in for <avr/pgmspace.h>. Flash and RAM are the same
+ * thing on the host, so these are plain accesses.
+ *********************************************************************/
+
+#ifndef HOST_AVR_PGMSPACE_H
+#define HOST_AVR_PGMSPACE_H
+
+#include <stdint.h>
+#include <string.h>
+#include <stdio.h>
+
+#define PROGMEM
+#define progmem             // as in __attribute__ ((progmem))
+#define PSTR(s)             (s)
+#define PGM_P               const char *
+
+#define pgm_read_byte(p)    (*(const uint8_t *)(p))
+#define pgm_read_word(p)    (*(const uint16_t *)(p))
+
+#define memcpy_P            memcpy
+#define strcpy_P            strcpy
+#define strlen_P            strlen
+#define strcmp_P            strcmp
+#define sprintf_P           sprintf
+
+#endif
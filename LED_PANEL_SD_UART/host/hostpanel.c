@@ -0,0 +1,584 @@
+/*********************************************************************
+ * hostpanel
+ *
+ * Host (Linux) build of the panel firmware, with a virtual LED panel.
+ *
+ * Usage: hostpanel [-n frames] [-o prefix] [-s scale] [-d] [-p|-j] [-c] mode
+ *
+ *   slideshow   run refreshDisplay() back to back, without waiting for
+ *               the scheduler
+ *   function2   run Function2Frame() when the scheduler says a frame is
+ *               due, from a loop like the firmware's main loop
+ *   cmd         run the firmware's main(); stdin goes into the uart,
+ *               replies come out on stdout. Ends when stdin does.
+ *
+ *   -n  stop after this many frames (default 10, cmd mode: no limit)
+ *   -o  write every frame to <prefix>NNNN.ppm
+ *   -s  scale the PPM frames up, one LED = scale x scale pixels
+ *   -d  make _delay_ms() take real time (always on in cmd mode)
+ *   -p  print the frame profile (profile.h) as CSV at the end
+ *   -j  same, as JSON
+ *   -c  check every string sent with its columns rotated (marquee,
+ *       set_column_offset) against the same buffer read out unrotated,
+ *       column by column. Mismatches go to stderr, exit status 1
+ *
+ * The output_grb* routines are replaced by versions that latch the data
+ * into two virtual strings, with the same brightness scaling as the
+ * assembly. A write made while WS2812.c's chunked output says it's
+ * carrying on a transfer (output_continued) is the next chunk of it,
+ * wherever in memory it comes from, anything else starts from the
+ * first LED. A frame is finished
+ * when a string starts again, so the slideshow's grb3 + grb4 pair (or
+ * its two grb_pal4 strings) and Function2's single grb are one frame
+ * each. The time the firmware
+ * spends between transfers is the frame build cost, reported at the end.
+ *
+ * Timer1 counts real time, as if the host ran at F_CPU, so the profile
+ * has the same slots and stages as on the panel, but the times are how
+ * long the firmware's C takes on the host CPU. -p and -j print them in
+ * host microseconds, not AVR cycles; on the panel 'g' 't' has the
+ * cycles. There are two stages, as the firmware times them: a frame is
+ * built in one pass (decoding, gamma and brightness for a picture,
+ * straight into buf), then output.
+ *
+ * Interrupts: a 10kHz timer signal plays the part of the interrupt
+ * hardware. Whenever SREG's I bit is set it runs the uart and Timer1
+ * compare ISRs, so the ring buffers, critical sections, busy-waits and
+ * the scheduler's tick work as on the AVR.
+ *********************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <signal.h>
+#include <time.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <errno.h>
+#include <sys/time.h>
+
+#include <avr/io.h>
+#include <avr/interrupt.h>
+
+#include "global.h"
+#include "WS2812.h"
+#include "commandprotocol.h"
+#include "profile.h"
+#include "scheduler.h"
+#include "hostpanel.h"
+
+#define TICK_US     100
+
+// firmware entry points
+int firmware_main(void);
+void refreshDisplay(void);
+void Function2Start(void);
+void Function2Frame(u08 *);
+extern u08 led_brightness; // WS2812.c
+extern u08 led_dither, led_dither_step;
+extern u08 output_continued;
+extern u08 buf[]; // main.c
+
+// registers
+volatile uint8_t PORTD, DDRD, PIND, PORTC, DDRC, PINC, PORTB, DDRB, PINB;
+volatile uint8_t SREG;
+volatile uint8_t UCSR0A, UCSR0B, UCSR0C, UBRR0L, UBRR0H;
+volatile uint8_t TCCR1A, TCCR1B, TIMSK1, TIFR1;
+volatile uint16_t OCR1A;
+static volatile uint16_t tcnt1;
+static volatile uint8_t udr;
+static volatile sig_atomic_t udrTouched;
+static uint8_t eeprom[E2END+1];
+
+// virtual panel
+u08 hostFrame[2*YBOUND][XBOUND][3];
+unsigned long hostFrames;
+static u08 leds[2][NUM_LEDS]; // what each string's LEDs have latched
+static u16 pos[2]; // next byte of each string
+static u08 written; // strings written since the last frame, bit per string
+static unsigned long frameLimit = 10;
+static int frameLimitSet;
+static const char *ppmPrefix;
+static int ppmScale = 1;
+static int realDelays;
+static int printProfile; // 'c' CSV, 'j' JSON, 0 none
+static int checkRotated;
+static unsigned long rotatedBad; // LEDs that didn't match
+static u08 raw[2][NUM_LEDS]; // what went into each string, before scaling
+static double buildStart, buildTotal, buildMin = 1e9, buildMax;
+static unsigned long buildCount;
+
+// emulated uart
+static int cmdMode;
+static volatile sig_atomic_t rxEof;
+static int txPending, txArmed, txBusy;
+static uint8_t txByte;
+
+static double now(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+/*********************************************************************
+ * Frames
+ *********************************************************************/
+static void writePpm(void) {
+  char name[256];
+  FILE *f;
+  int x, y, sx, sy;
+
+  snprintf(name, sizeof(name), "%s%04lu.ppm", ppmPrefix, hostFrames);
+  f = fopen(name, "wb");
+  if (!f) {
+    fprintf(stderr, "hostpanel: can't write %s\n", name);
+    exit(1);
+  }
+  fprintf(f, "P6\n%d %d\n255\n", XBOUND * ppmScale, 2 * YBOUND * ppmScale);
+  // y = 0 at the bottom, the way the pictures are stored
+  for (y = 2 * YBOUND - 1; y >= 0; y--) {
+    for (sy = 0; sy < ppmScale; sy++) {
+      for (x = 0; x < XBOUND; x++) {
+        for (sx = 0; sx < ppmScale; sx++) {
+          fwrite(hostFrame[y][x], 1, 3, f);
+        }
+      }
+    }
+  }
+  fclose(f);
+}
+
+static void finishFrame(void) {
+  int x, y;
+  u16 led;
+  u08 *grb;
+
+  for (y = 0; y < 2 * YBOUND; y++) {
+    for (x = 0; x < XBOUND; x++) {
+      led = pixel_map[y * XBOUND + x];
+      grb = &leds[led / NUM_WS2812][3 * (led % NUM_WS2812)];
+      hostFrame[y][x][0] = grb[1];
+      hostFrame[y][x][1] = grb[0];
+      hostFrame[y][x][2] = grb[2];
+    }
+  }
+  if (ppmPrefix) {
+    writePpm();
+  }
+  hostFrames++;
+  written = 0;
+}
+
+// Timer1 counts of host time, in microseconds
+#define HOST_US(t) (PROF_CYCLES(t) / (F_CPU / 1000000.0))
+
+// what a profile slot is for, see profile.h
+static const char *slotName(int slot) {
+  static char name[16];
+
+  if (slot == PROF_MARQUEE) {
+    return "marquee";
+  }
+  if (slot >= PROF_EFFECT(0)) {
+    snprintf(name, sizeof(name), "effect%d", slot - PROF_EFFECT(0));
+  } else {
+    snprintf(name, sizeof(name), "picture%d", slot - PROF_PICTURE(1) + 1);
+  }
+  return name;
+}
+
+static void finish(void) {
+  const profSlot *s;
+  int slot, first;
+
+  if (written) {
+    finishFrame();
+  }
+  fprintf(stderr, "hostpanel: %lu frames", hostFrames);
+  if (buildCount) {
+    fprintf(stderr, ", build %.3f ms/frame (min %.3f, max %.3f)",
+            buildTotal / buildCount * 1000, buildMin * 1000, buildMax * 1000);
+  }
+  fprintf(stderr, "\n");
+  if (checkRotated) {
+    fprintf(stderr, "hostpanel: %lu rotated LEDs wrong\n", rotatedBad);
+  }
+  if (printProfile == 'c') {
+    printf("slot,name,frames,build_last_us,build_max_us,output_last_us,output_max_us\n");
+  } else if (printProfile == 'j') {
+    printf("{\"unit\": \"host_us\", \"slots\": [");
+  }
+  for (slot = 0, first = 1; printProfile && slot < PROF_SLOTS; slot++) {
+    s = profileGet(slot);
+    if (!s->frames) {
+      continue;
+    }
+    if (printProfile == 'c') {
+      printf("%d,%s,%u,%.1f,%.1f,%.1f,%.1f\n", slot, slotName(slot), s->frames,
+             HOST_US(s->last[PROF_BUILD]), HOST_US(s->max[PROF_BUILD]),
+             HOST_US(s->last[PROF_OUTPUT]), HOST_US(s->max[PROF_OUTPUT]));
+    } else {
+      printf("%s\n  {\"slot\": %d, \"name\": \"%s\", \"frames\": %u, "
+             "\"build_last\": %.1f, \"build_max\": %.1f, "
+             "\"output_last\": %.1f, \"output_max\": %.1f}",
+             first ? "" : ",", slot, slotName(slot), s->frames,
+             HOST_US(s->last[PROF_BUILD]), HOST_US(s->max[PROF_BUILD]),
+             HOST_US(s->last[PROF_OUTPUT]), HOST_US(s->max[PROF_OUTPUT]));
+    }
+    first = 0;
+  }
+  if (printProfile == 'j') {
+    printf("\n]}\n");
+  }
+  exit(rotatedBad ? 1 : 0);
+}
+
+// start of an output call: account the build time, and start a new
+// frame if a string that already has data in this one starts again
+static void outputBegin(u08 strings, u08 starts) {
+  double t = now() - buildStart;
+
+  if (written & starts) {
+    finishFrame();
+    if (frameLimit && hostFrames >= frameLimit) {
+      finish();
+    }
+  }
+  if (starts) { // the time between chunks isn't build time
+    if (!written) { // build time counts per frame
+      buildCount++;
+    }
+    buildTotal += t;
+    if (t < buildMin) buildMin = t;
+    if (t > buildMax) buildMax = t;
+  }
+  written |= strings;
+}
+
+static void outputEnd(void) {
+  buildStart = now();
+}
+
+// TRUE unless this is the next chunk of a transfer (chunked output,
+// WS2812.c), so the string latches and starts from its first LED
+static u08 starts(void) {
+  return !output_continued;
+}
+
+// a byte scaled and dithered like the assembly does
+static u08 scaled(u08 v) {
+  u08 out = (v * led_brightness + led_dither) >> 8;
+
+  led_dither += led_dither_step;
+  return out;
+}
+
+// a whole string went out with its columns rotated: each LED has to
+// have got the pixel of its column in the unrotated picture, that is
+// from buffer column column_x(x)
+static void checkRotatedString(u08 string) {
+  const u08 *p = buf;
+  u16 led, from;
+  u08 x, y;
+
+#ifdef WS2812_DUAL_LANE
+  p += string*NUM_LEDS;
+#endif
+  for (y = string*YBOUND; y < (string+1)*YBOUND; y++) {
+    for (x = 0; x < XBOUND; x++) {
+      led = pixel_led(x, y) % NUM_WS2812;
+      from = pixel_led(column_x(x), y) % NUM_WS2812;
+      if (memcmp(&raw[string][3*led], &p[3*from], 3)) {
+        if (!rotatedBad) {
+          fprintf(stderr, "hostpanel: frame %lu, offset %u: x %u y %u is wrong\n",
+                  hostFrames, get_column_offset(), x, y);
+        }
+        rotatedBad++;
+      }
+    }
+  }
+}
+
+// shift count bytes into a string, scaled or as they are, from its
+// first LED if a transfer starts with them
+static void latch(u08 string, const u08 *ptr, u16 count, u08 scale, u08 start) {
+  u16 i;
+
+  if (start) {
+    pos[string] = 0;
+  }
+  for (i = 0; i < count && pos[string] < NUM_LEDS; i++) {
+    raw[string][pos[string]] = ptr[i];
+    leds[string][pos[string]++] = scale ? scaled(ptr[i]) : ptr[i];
+  }
+  if (checkRotated && i && (pos[string] == NUM_LEDS) && get_column_offset()) {
+    checkRotatedString(string);
+  }
+}
+
+/*********************************************************************
+ * output_grb* stand-ins
+ *********************************************************************/
+void output_grb(u08 *ptr, u16 count) {
+  outputBegin(1, starts());
+  latch(0, ptr, count, FALSE, starts()); // PD3, no brightness
+  outputEnd();
+}
+
+void output_grb3(u08 *ptr, u16 count) {
+  outputBegin(1, starts());
+  latch(0, ptr, count, TRUE, starts());
+  outputEnd();
+}
+
+void output_grb4(u08 *ptr, u16 count) {
+  outputBegin(2, starts() << 1);
+  latch(1, ptr, count, TRUE, starts());
+  outputEnd();
+}
+
+void output_grb34s(u08 *ptr, u16 count, u16 stride) {
+  u08 start = starts();
+  u16 i;
+
+  outputBegin(3, start ? 3 : 0);
+  // a byte for each lane in turn, for the dithering
+  for (i = 0; i < count; i++) {
+    latch(0, ptr + i, 1, TRUE, start && !i);
+    latch(1, ptr + stride + i, 1, TRUE, start && !i);
+  }
+  outputEnd();
+}
+
+void output_grb34(u08 *ptr, u16 count) {
+  output_grb34s(ptr, count, count);
+}
+
+void output_grb_pal(u08 *idx, u16 count, u08 *palette, u08 outmask) {
+  static u08 grb[NUM_LEDS];
+  u16 i;
+  u08 strings = ((outmask & (1 << PIND3)) ? 1 : 0) | ((outmask & (1 << PIND4)) ? 2 : 0);
+
+  outputBegin(strings, strings); // always a whole string
+  for (i = 0; i < count && i < NUM_WS2812; i++) {
+    memcpy(&grb[3 * i], &palette[3 * idx[i]], 3);
+  }
+  count = i;
+  for (i = 0; i < 2; i++) {
+    if (strings & (1 << i)) {
+      latch(i, grb, 3 * count, FALSE, TRUE);
+    }
+  }
+  outputEnd();
+}
+
+// chunked like output_grb3/4, so it carries on where the last chunk
+// stopped. The palette has the brightness in it already
+void output_grb_pal4(u08 *idx, u16 count, u08 *palette, u08 outmask) {
+  u08 string = (outmask & (1 << PIND4)) ? 1 : 0;
+  u08 start = starts();
+  u08 index;
+  u16 i;
+
+  outputBegin(1 << string, start << string);
+  for (i = 0; i < count; i++) {
+    index = (i & 1) ? (idx[i / 2] & 0x0F) : (idx[i / 2] >> 4);
+    latch(string, &palette[3 * index], 3, FALSE, start && !i);
+  }
+  outputEnd();
+}
+
+/*********************************************************************
+ * Peripherals
+ *********************************************************************/
+volatile uint8_t *hostUdr(void) {
+  udrTouched = 1;
+  return &udr;
+}
+
+volatile uint16_t *hostTcnt1(void) {
+  static const int prescale[8] = {0, 1, 8, 64, 256, 1024, 0, 0};
+  int p = prescale[TCCR1B & 7];
+
+  if (p) { // stopped otherwise
+    tcnt1 = (uint16_t)(unsigned long long)(now() * (F_CPU / p));
+  }
+  return &tcnt1;
+}
+
+uint8_t eeprom_read_byte(const uint8_t *addr) {
+  return eeprom[(uintptr_t)addr & E2END];
+}
+
+void eeprom_write_byte(uint8_t *addr, uint8_t value) {
+  eeprom[(uintptr_t)addr & E2END] = value;
+}
+
+void hostDelayUs(double us) {
+  struct timespec ts;
+  if (!realDelays) {
+    return;
+  }
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  ts.tv_nsec += (long)(us * 1000);
+  ts.tv_sec += ts.tv_nsec / 1000000000;
+  ts.tv_nsec %= 1000000000;
+  // the tick signal cuts the sleep short, sleep on to the same end time
+  while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, NULL) == EINTR);
+}
+
+// take a byte the firmware put in UDR
+static void txTake(void) {
+  if (udrTouched) {
+    udrTouched = 0;
+    txByte = udr;
+    txPending = 1;
+  }
+}
+
+// the timer signal: one pass of interrupt handling
+static void tick(int sig) {
+  uint8_t c;
+  int n;
+
+  (void)sig;
+  if (!(SREG & 0x80)) {
+    return; // interrupts off, try again next tick
+  }
+  SREG &= ~0x80; // as on entry to an ISR
+
+  if ((TIMSK1 & BV(OCIE1A)) && (int16_t)(TCNT1 - OCR1A) >= 0) {
+    TIMER1_COMPA_vect();
+  }
+
+  // transmitter: a byte takes one tick to go out
+  if (txPending) {
+    n = write(1, &txByte, 1);
+    (void)n;
+    txPending = 0;
+    txBusy = 1;
+  }
+  // a write to UDR from the mainline may not have landed yet when the
+  // signal arrived, so pick it up one tick later
+  if (txArmed) {
+    txArmed = 0;
+    txTake();
+  } else if (udrTouched) {
+    txArmed = 1;
+  }
+  if (!txPending && !txArmed && (UCSR0B & BV(UDRIE0))) {
+    USART_UDRE_vect();
+    txTake();
+  }
+  if (!txPending && !txArmed && txBusy && !(UCSR0B & BV(UDRIE0))) {
+    txBusy = 0;
+    if (UCSR0B & BV(TXCIE0)) {
+      USART_TX_vect();
+      txTake();
+    }
+  }
+
+  // receiver
+  if (cmdMode && !rxEof && (UCSR0B & BV(RXCIE0))) {
+    n = read(0, &c, 1);
+    if (n == 1) {
+      udr = c;
+      USART_RX_vect();
+      udrTouched = 0; // that was a read
+    } else if (n == 0) {
+      rxEof = 1;
+    }
+  }
+
+  SREG |= 0x80;
+
+  // cmd mode ends when the input is used up and everything is answered
+  if (rxEof && !txPending && !txArmed && !txBusy && !(UCSR0B & BV(UDRIE0)) &&
+      !isCommandReady() && !rxCommandProcessing) {
+    finish();
+  }
+}
+
+static void startTicks(void) {
+  struct sigaction sa;
+  struct itimerval it;
+
+  memset(&sa, 0, sizeof(sa));
+  sa.sa_handler = tick;
+  sa.sa_flags = SA_RESTART;
+  sigaction(SIGALRM, &sa, NULL);
+  it.it_interval.tv_sec = 0;
+  it.it_interval.tv_usec = TICK_US;
+  it.it_value = it.it_interval;
+  setitimer(ITIMER_REAL, &it, NULL);
+}
+
+static void usage(void) {
+  fprintf(stderr, "usage: hostpanel [-n frames] [-o prefix] [-s scale] [-d] [-p|-j] [-c] slideshow|function2|cmd\n");
+  exit(2);
+}
+
+int main(int argc, char **argv) {
+  const char *mode = NULL;
+  int i;
+
+  for (i = 1; i < argc; i++) {
+    if (!strcmp(argv[i], "-n") && i + 1 < argc) {
+      frameLimit = strtoul(argv[++i], NULL, 0);
+      frameLimitSet = 1;
+    } else if (!strcmp(argv[i], "-o") && i + 1 < argc) {
+      ppmPrefix = argv[++i];
+    } else if (!strcmp(argv[i], "-s") && i + 1 < argc) {
+      ppmScale = atoi(argv[++i]);
+    } else if (!strcmp(argv[i], "-d")) {
+      realDelays = 1;
+    } else if (!strcmp(argv[i], "-p")) {
+      printProfile = 'c';
+    } else if (!strcmp(argv[i], "-j")) {
+      printProfile = 'j';
+    } else if (!strcmp(argv[i], "-c")) {
+      checkRotated = 1;
+    } else if (argv[i][0] == '-' || mode) {
+      usage();
+    } else {
+      mode = argv[i];
+    }
+  }
+  if (!mode || ppmScale < 1) {
+    usage();
+  }
+
+  memset(eeprom, 0xFF, sizeof(eeprom));
+  led_brightness = 255; // the firmware sets its own in main()
+  buildStart = now();
+  profileInit(); // the firmware's main() does these too
+  schedInit();
+  SREG |= 0x80;
+  startTicks();
+
+  if (!strcmp(mode, "slideshow")) {
+    for (;;) {
+      refreshDisplay();
+    }
+  } else if (!strcmp(mode, "function2")) {
+    static u08 f2buf[NUM_LEDS];
+    Function2Start();
+    while (int_flag == 0) { // the main loop a Function2 build would have
+      if (schedFrameDue()) {
+        Function2Frame(f2buf);
+      }
+    }
+  } else if (!strcmp(mode, "cmd")) {
+    cmdMode = 1;
+    realDelays = 1;
+    if (!frameLimitSet) {
+      frameLimit = 0;
+    }
+    fcntl(0, F_SETFL, fcntl(0, F_GETFL) | O_NONBLOCK);
+    firmware_main();
+  } else {
+    usage();
+  }
+  finish();
+  return 0;
+}
@@ -0,0 +1,20 @@
+/*********************************************************************
+ * hostpanel.h
+ *
+ * Virtual LED panel for the host build. The output_grb* stand-ins in
+ * hostpanel.c latch data into two virtual strings, like the real LEDs,
+ * and every finished frame is rendered into hostFrame.
+ *********************************************************************/
+
+#ifndef HOSTPANEL_H
+#define HOSTPANEL_H
+
+#include "global.h"
+#include "WS2812.h"
+
+// last finished frame, RGB, indexed [y][x] like pixel_map
+extern u08 hostFrame[2*YBOUND][XBOUND][3];
+// frames finished so far
+extern unsigned long hostFrames;
+
+#endif
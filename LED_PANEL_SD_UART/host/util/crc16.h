@@ -0,0 +1,18 @@
+/*********************************************************************
+ * Host build stand-in for <util/crc16.h>, the C version avr-libc
+ * gives for _crc_ccitt_update().
+ *********************************************************************/
+
+#ifndef HOST_UTIL_CRC16_H
+#define HOST_UTIL_CRC16_H
+
+#include <stdint.h>
+
+static inline uint16_t _crc_ccitt_update(uint16_t crc, uint8_t data) {
+  data ^= crc & 0xFF;
+  data ^= data << 4;
+  return ((((uint16_t)data << 8) | (crc >> 8)) ^ (uint8_t)(data >> 4)
+          ^ ((uint16_t)data << 3));
+}
+
+#endif
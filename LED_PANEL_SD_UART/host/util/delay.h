@@ -0,0 +1,14 @@
+/*********************************************************************
+ * Host build stand-in for <util/delay.h>. Delays only take real time
+ * with hostpanel -d, but they always let the uart run.
+ *********************************************************************/
+
+#ifndef HOST_UTIL_DELAY_H
+#define HOST_UTIL_DELAY_H
+
+void hostDelayUs(double us);
+
+#define _delay_ms(ms)   hostDelayUs((ms) * 1000.0)
+#define _delay_us(us)   hostDelayUs(us)
+
+#endif
@@ -11,9 +11,7 @@
  ************************************************************************/
 
 #include <stdint.h>
-#include <stdio.h>
 #include <string.h>
-#include <stdlib.h> // atoi
 
 #include <avr/io.h>
 #include <avr/interrupt.h>
@@ -22,719 +20,197 @@
 #include "global.h" // F_CPU may be req'd by other imports
 #include "rprintf.h"
 #include "WS2812.h"
-#include "bufferchris.h"
+#include "ringbuffer.h"
 #include "uartchris.h"
 #include "commandprotocol.h"
+#include "rleimage.h"
+#include "profile.h"
+#include "scheduler.h"
+#include "font.h"
 
 #include <util/delay.h> // depends on FCPU in global.h
 
+// panel brightness at power up, 26/256 is about what the old div = 10 gave
+#define DEFAULT_BRIGHTNESS 26
+
+// current each string may draw, mA, 'p' cmd changes it. Set it to what
+// the string's supply gives, brighter frames are dimmed to fit
+#define POWER_BUDGET_MA 5000
+
+// 'b' string on the panel: text color, and the background of its line.
+// The rest of the panel goes black.
+#define TEXT_FG 255, 255, 255
+#define TEXT_BG 0, 0, 0
+
+// marquee: the 'b' string scrolls along the middle of this string, one
+// column every MARQUEE_MS unless the 'm' cmd says otherwise, with this
+// many blank columns before it comes round again
+#define MARQUEE_STRING STRING_LOWER
+#define MARQUEE_MS 50
+#define MARQUEE_GAP 8
+
+// slideshow: each picture is shown this long, 's' cmd changes it
+#define PICTURE_MS 1000
+
+// a frame isn't output while a cmd for us is coming in, unless nothing
+// has come in for this long (the master gave up on it halfway)
+#define CMD_HOLD_MS 100
+
+// output goes out in chunks of about one uart character time (10 bits),
+// the uart holds 2 so none get lost. A byte takes 170 cycles in
+// output_grb3/4, a byte pair 177 (11.1us) in output_grb34.
+#define OUTPUT_CHUNK(baud) ((u16)(10*1000000UL/12/(baud) + 1))
+// That only works if a chunk is done before 2 characters have come in.
+// Above ~1.4 Mbaud not even a one byte chunk is, so 'u' won't go there.
+// EXTRA is the rest of a chunk with interrupts off, the call and the
+// timing around it, roughly.
+#define OUTPUT_BYTE_CYCLES 177
+#define OUTPUT_CHUNK_EXTRA 50
+#define OUTPUT_CHUNK_FITS(baud) \
+  ((u32)OUTPUT_CHUNK(baud)*OUTPUT_BYTE_CYCLES + OUTPUT_CHUNK_EXTRA <= 2*10UL*F_CPU/(baud))
+
+// after a 'u' baud change, the master has this long to send a cmd at the
+// new rate, or we go back to the old one
+#define BAUD_CONFIRM_MS 2000
+
 // define global variables
-u08 buf[NUM_LEDS]; // half display
+#ifdef WS2812_DUAL_LANE
+u08 buf[NUM_LEDS*2]; // whole display, upper string then lower string
+#else
+u08 buf[NUM_LEDS]; // half display, or a picture as palette indices
+#endif
 u16 bufindex;
 char myVolatileStr[40];
+u32 baudNext; // 'u' cmd rate, switched to once the ack is out. 0 if none
+u32 baudFallback; // rate to go back to if the new one isn't confirmed. 0 if none
+u16 baudConfirmStart; // schedMillis() when the new rate was set
+u08 picnum = 0; // picture the slideshow shows, 0 = none yet
+u08 rxSeen; // rxByteCount when the main loop last looked
+u16 rxSeenMs; // schedMillis() then
+u08 textShown; // the panel shows the 'b' string, not a picture
+u08 streamsSeen; // getStreamsBegun() when the main loop last looked
+textStyle textSt = { &font5x7, {TEXT_FG}, {TEXT_BG} };
+u08 marqueeOn; // the 'b' string scrolls, see marqueeShow()
+u16 marqueeCol; // column of the text that comes in next
+#ifndef WS2812_DUAL_LANE
+// what each string shows, with half a panel of buffer: a picnum, or
+#define SHOWN_NONE 0 // not known, something else was sent to it
+#define SHOWN_TEXT 0xFF // the 'b' string
+u08 shown[2];
+u08 framePic; // picture whose palette indices are in buf, 0 = none
+#endif
 
 // function prototypes
 void processCmd(void);
-void setVolatileString(unsigned char *);
-unsigned char * getVolatileString(void);
-void loopRefreshingDisplay(void);
+char * getVolatileString(void);
+void fillBufferHalf(u08 *, u08, u16);
+void refreshDisplay(void);
+void redrawDisplay(void);
+void showText(void);
+void marqueeStart(u16);
+void marqueeStop(void);
+void marqueeShow(u08);
+u16 marqueeColumnSum(const u08 *, u08, s16);
+#ifndef WS2812_DUAL_LANE
+void markIfNew(u08, u08);
+u08 palFits(u08);
+void fillPalFrame(u08);
+void powerPalString(u08, const u08 *);
+#endif
+void setBaudRate(u32);
+void handleAddr(u32);
+void handleLevel(u32);
+void handleDither(u32);
+void handlePower(u32);
+void handleBaud(u32);
+void handleString(u32);
+void handleMarquee(u32);
+void handleSlideshow(u32);
+void streamBegun(void);
+u08 bufBusy(void);
+u08 buildSpoiled(u08, u16, u16);
+void handleStream(u32);
+void handleChunk(u32);
+void handleGet(u32);
+void replyAddr(u32);
+void replyString(u32);
+void replyLevel(u32);
+void replyDither(u32);
+void replyPower(u32);
+void replyErrors(u32);
+void replyFrames(u32);
+void replyOutput(u32);
+void replyProfile(u32);
 
 /*************************************************/
+/* Commands, see processCmd()                    */
 /*************************************************/
-/* BLOCK 1-4: USS Christmas tree scene, snowing. */
-// BMP data has two bytes of zeroes at the end of each line,
-// but this is edited out by Hex Editor NEO.
-/*************************************************/
-/*************************************************/
+const char errBadAddr[] PROGMEM = "err-badaddr";
+const char errBadLevel[] PROGMEM = "err-badlevel";
+const char errBadBudget[] PROGMEM = "err-badbudget";
+const char errBadBaud[] PROGMEM = "err-badbaud";
+const char errBadPeriod[] PROGMEM = "err-badperiod";
+const char errStream[] PROGMEM = "err-stream";
+const char errBadSlot[] PROGMEM = "err-badslot$";
+const char errCmd[] PROGMEM = "err-cmd$";
+const char errGetNoProp[] PROGMEM = "err-getnoprop$";
 
-// Created with HHD Software Hex Editor Neo
-// http://www.hhdsoftware.com
-//
-// File: C:\Users\Chris\Pictures\ussxmas3.bmp
-//
-// Block n:
-// Offset: 0x00000036 (54)
-// Size: 0x00000a52 (2,642) bytes
-
-const u08 block1[] PROGMEM = {
-	0xe4, 0xe7, 0xff, 0xe3, 0xe7, 0xff, 0xe0, 0xe4, 0xff, 0xe1, 0xe5, 0xff, 0xe2, 0xe6, 0xff, 0xe4,
-	0xe7, 0xff, 0xe6, 0xea, 0xff, 0xe7, 0xeb, 0xff, 0xe3, 0xe7, 0xff, 0xdf, 0xe2, 0xff, 0xe1, 0xe5,
-	0xff, 0xe1, 0xe4, 0xff, 0xd6, 0xda, 0xff, 0xcd, 0xd0, 0xff, 0xc7, 0xca, 0xff, 0xc4, 0xc7, 0xff,
-	0xe0, 0xe4, 0xff, 0xdf, 0xe2, 0xff, 0xd7, 0xdb, 0xff, 0xde, 0xe2, 0xff, 0xdc, 0xdf, 0xff, 0xc7,
-	0xc9, 0xff, 0xc0, 0xc3, 0xff, 0xc1, 0xc4, 0xff, 0xc8, 0xcb, 0xff, 0xd2, 0xd6, 0xff, 0xe8, 0xeb,
-	0xff, 0xf5, 0xf9, 0xff, 0xfa, 0xfe, 0xff, 0xfb, 0xfe, 0xff, 0xf8, 0xfc, 0xff, 0xe8, 0xec, 0xff,
-	0xdf, 0xe2, 0xff, 0xf9, 0xfd, 0xff, 0xf7, 0xfb, 0xff, 0xf7, 0xfb, 0xff, 0xf6, 0xfa, 0xff, 0xf2,
-	0xf6, 0xff, 0xf3, 0xf7, 0xff, 0xe3, 0xe7, 0xff, 0xf0, 0xf4, 0xff, 0xd5, 0xd9, 0xff, 0xe6, 0xe9,
-	0xff, 0xec, 0xf0, 0xff, 0xef, 0xf2, 0xff, 0xf1, 0xf5, 0xff, 0xee, 0xf2, 0xff, 0xed, 0xf1, 0xff,
-	0xec, 0xf0, 0xff, 0xe6, 0xea, 0xff, 0xb9, 0xbc, 0xff, 0xbb, 0xbe, 0xff, 0xbd, 0xc0, 0xff, 0xaa,
-	0xac, 0xff, 0xb8, 0xba, 0xff, 0xc6, 0xc9, 0xff, 0xda, 0xdd, 0xff, 0xdb, 0xdf, 0xff, 0xd8, 0xdc,
-	0xff, 0xe6, 0xea, 0xff, 0xe0, 0xe4, 0xff, 0xdc, 0xdf, 0xff, 0xd0, 0xd3, 0xff, 0xb5, 0xb9, 0xff,
-	0xa9, 0xac, 0xff, 0xe5, 0xe8, 0xff, 0xd4, 0xd8, 0xff, 0xb4, 0xb7, 0xff, 0xd3, 0xd6, 0xff, 0x9e,
-	0xa0, 0xff, 0x4b, 0x4d, 0xff, 0x6f, 0x71, 0xff, 0xa4, 0xa7, 0xff, 0xa0, 0xa2, 0xff, 0x7f, 0x81,
-	0xff, 0x9d, 0x9f, 0xff, 0xbc, 0xbf, 0xff, 0xd2, 0xd5, 0xff, 0xdf, 0xe3, 0xff, 0xc6, 0xc9, 0xff,
-	0xed, 0xf1, 0xff, 0xed, 0xf1, 0xff, 0xb2, 0xb4, 0xff, 0x4d, 0x4e, 0xff, 0x21, 0x22, 0xff, 0x05,
-	0x05, 0xff, 0x3c, 0x3d, 0xff, 0x7e, 0x80, 0xff, 0xaa, 0xad, 0xff, 0xd6, 0xd9, 0xff, 0xfa, 0xfe,
-	0xff, 0xf6, 0xfa, 0xff, 0xef, 0xf3, 0xff, 0xf7, 0xfb, 0xff, 0xf7, 0xfb, 0xff, 0xfa, 0xfe, 0xff,
-	0xfb, 0xff, 0xff, 0xf5, 0xf9, 0xff, 0xe2, 0xe6, 0xff, 0xdb, 0xde, 0xff, 0xe2, 0xe5, 0xff, 0xeb,
-	0xef, 0xff, 0xe9, 0xed, 0xff, 0xe8, 0xec, 0xff, 0xf5, 0xf9, 0xff, 0xbd, 0xc0, 0xff, 0xab, 0xae,
-	0xff, 0xaf, 0xb2, 0xff, 0xbf, 0xc2, 0xff, 0xb2, 0xb4, 0xff, 0x0a, 0x0a, 0xff, 0x11, 0x43, 0x78,
-	0x11, 0x43, 0x78, 0x11, 0x43, 0x78, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00,
-	0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x43, 0x44, 0xff, 0xc0, 0xc3,
-	0xff, 0xd0, 0xd3, 0xff, 0xce, 0xd1, 0xff, 0xde, 0xe2, 0xff, 0xb4, 0xb7, 0xff, 0x74, 0x76, 0xff,
-	0x34, 0x35, 0xff, 0x10, 0x10, 0xff, 0xa0, 0xa2, 0xff, 0xaf, 0xb1, 0xff, 0x26, 0x27, 0xff, 0x01,
-	0x01, 0xff, 0x56, 0x58, 0xff, 0x78, 0x7a, 0xff, 0x7b, 0x7d, 0xff, 0x98, 0x9b, 0xff, 0x33, 0x34,
-	0xff, 0x3d, 0x3e, 0xff, 0x2a, 0x2b, 0xff, 0x17, 0x18, 0xff, 0x1b, 0x1b, 0xff, 0x32, 0x33, 0xff,
-	0xd9, 0xdc, 0xff, 0x26, 0x27, 0xff, 0x25, 0x26, 0xff, 0x21, 0x22, 0xff, 0x0e, 0x0e, 0xff, 0x00,
-	0x00, 0xff, 0x00, 0x00, 0xff, 0x11, 0x43, 0x78, 0x11, 0x43, 0x78, 0x11, 0x43, 0x78, 0x00, 0x00,
-	0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x57, 0x59, 0xff, 0xf4, 0xf8, 0xff, 0x00, 0x00, 0xff,
-	0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x27, 0x28, 0xff, 0x27, 0x28, 0xff, 0x14,
-	0x14, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x56, 0x57, 0xff, 0x7a, 0x7c,
-	0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x02, 0x02, 0xff, 0x46, 0x48, 0xff,
-	0x82, 0x83, 0xff, 0x24, 0x25, 0xff, 0x04, 0x04, 0xff, 0x00, 0x00, 0xff, 0x4a, 0x4b, 0xff, 0xf4,
-	0xf8, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00,
-	0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x11, 0x43, 0x78,
-	0x11, 0x43, 0x78, 0x11, 0x43, 0x78, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x12,
-	0x12, 0xff, 0x57, 0x59, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00,
-	0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff,
-	0x00, 0x00, 0xff, 0x11, 0x11, 0xff, 0x1e, 0x1e, 0xff, 0x83, 0x85, 0xff, 0x3b, 0x3c, 0xff, 0x00,
-	0x00, 0xff, 0x1e, 0x1e, 0xff, 0x52, 0x53, 0xff, 0x9c, 0x9e, 0xff, 0xb5, 0xb8, 0xff, 0x00, 0x00,
-	0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff,
-	0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0xec, 0x01, 0x00, 0xef, 0x01, 0x00,
-	0xef, 0x00, 0x00, 0xfe, 0x00, 0x00, 0xbd, 0x02, 0x0c, 0x4e, 0x54, 0x11, 0x43, 0x78, 0x00, 0x00,
-	0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff,
-	0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x33, 0x34, 0xff, 0x9d, 0x9f, 0xff, 0x00,
-	0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x29, 0x2a, 0xff, 0x0b, 0x0b,
-	0xff, 0xc3, 0xc6, 0xff, 0x81, 0x83, 0xff, 0x07, 0x07, 0xff, 0x40, 0x40, 0xff, 0x45, 0x46, 0xff,
-	0xda, 0xde, 0xff, 0xa6, 0xa8, 0xff, 0x27, 0x28, 0xff, 0x13, 0x14, 0xff, 0x00, 0x00, 0xff, 0x00,
-	0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00,
-	0xff, 0x00, 0x00, 0xfe, 0x00, 0xf8, 0x00, 0x00, 0xe2, 0x01, 0x00, 0xd5, 0x02, 0x00, 0xd4, 0x01,
-	0x00, 0xdd, 0x01, 0x00, 0xb6, 0x02, 0x00, 0x96, 0x03, 0x00, 0xc5, 0x02, 0x00, 0x09, 0xe8, 0x00,
-	0x07, 0xed, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00,
-	0xff, 0x0a, 0x0a, 0xff, 0x1f, 0x1f, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff,
-	0x07, 0x07, 0xff, 0xde, 0xe2, 0xff, 0x00, 0x00, 0xff, 0x29, 0x2a, 0xff, 0x35, 0x36, 0xff, 0x10,
-	0x11, 0xff, 0x14, 0x14, 0xff, 0x6b, 0x6d, 0xff, 0x4b, 0x4c, 0xff, 0x29, 0x2a, 0xff, 0x17, 0x17,
-	0xff, 0x1d, 0x1e, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff,
-	0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0xff, 0x00, 0x23,
-	0xff, 0x24, 0x6b, 0xfc, 0x6d, 0x00, 0xea, 0x00, 0x00, 0xd4, 0x01, 0x00, 0x9f, 0x03, 0x00, 0x9a,
-	0x02, 0x00, 0xbf, 0x02, 0x00, 0xc3, 0x02, 0x00, 0xb3, 0x02, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff,
-	0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00,
-	0x00, 0xff, 0x15, 0x15, 0xff, 0x3f, 0x40, 0xff, 0x0c, 0x0c, 0xff, 0x91, 0x93, 0xff, 0x00, 0x00,
-	0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x03, 0x03, 0xff, 0x15, 0x16, 0xff,
-	0x27, 0x27, 0xff, 0x3c, 0x3d, 0xff, 0x1e, 0x1e, 0xff, 0x17, 0x17, 0xff, 0x00, 0x00, 0xff, 0x00,
-	0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00,
-	0xff, 0x07, 0x02, 0xfd, 0x05, 0x02, 0xfd, 0x1a, 0xff, 0x1a, 0x4e, 0xff, 0x4f, 0x00, 0xff, 0x00,
-	0x00, 0xde, 0x01, 0x00, 0xe2, 0x00, 0x00, 0xd6, 0x01, 0x00, 0xb5, 0x01, 0x00, 0xc9, 0x01, 0x00,
-	0x0d, 0xe1, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0xe8, 0x96,
-	0x00, 0xe8, 0x96, 0x00, 0xe8, 0x96, 0x00, 0xe8, 0x96, 0x00, 0x28, 0x29, 0xff, 0x7c, 0x7e, 0xff,
-	0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0xe8, 0x96, 0x00, 0xe8, 0x96, 0x00, 0x00,
-	0x00, 0xff, 0x0a, 0x0a, 0xff, 0x35, 0x36, 0xff, 0x3c, 0x3d, 0xff, 0x63, 0x65, 0xff, 0xe8, 0x96,
-	0x00, 0xe8, 0x96, 0x00, 0xe8, 0x96, 0x00, 0xe8, 0x96, 0x00, 0xe8, 0x96, 0x00, 0x00, 0x00, 0xff,
-	0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0xe8, 0x96, 0x00, 0x03, 0x01, 0xfe, 0x03, 0x01, 0xfe, 0x00,
-	0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xf3, 0x00, 0x0b, 0xe6, 0x0b, 0x4e, 0xb5,
-	0x52, 0x00, 0x0d, 0xdf, 0x00, 0x05, 0xf0, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x43, 0x45, 0xff,
-	0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0xe8, 0x96, 0x00, 0xe8, 0x96, 0x00, 0xe8, 0x96, 0x00, 0xe8,
-	0x96, 0x00, 0xe8, 0x96, 0x00, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0xe8, 0x96,
-	0x00, 0xe8, 0x96, 0x00, 0xe8, 0x96, 0x00, 0xe8, 0x96, 0x00, 0xe8, 0x96, 0x00, 0x37, 0x38, 0xff,
-	0x27, 0x28, 0xff, 0xe3, 0x94, 0x0c, 0xe8, 0x96, 0x00, 0xe8, 0x96, 0x00, 0xe8, 0x96, 0x00, 0xe8,
-	0x96, 0x00, 0xe8, 0x96, 0x00, 0xe8, 0x96, 0x00, 0x00, 0x00, 0xff, 0xe8, 0x96, 0x00, 0xe8, 0x96,
-	0x00, 0xe8, 0x96, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00,
-	0x00, 0xf7, 0x00, 0x04, 0xe2, 0x06, 0x1c, 0xa0, 0x1f, 0x00, 0x9d, 0x03, 0x00, 0xe0, 0x01, 0x00,
-	0x00, 0xff, 0x00, 0x00, 0xff, 0xab, 0xae, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0xe8, 0x96,
-	0x00, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0xe8, 0x96, 0x00, 0xe8, 0x96, 0x00, 0x00, 0x00, 0xff,
-	0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0xe8,
-	0x96, 0x00, 0xe8, 0x96, 0x00, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00,
-	0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0xe8, 0x96, 0x00, 0xe8, 0x96, 0x00, 0xe8, 0x96, 0x00,
-	0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0xe8, 0x96, 0x00, 0x00, 0x00, 0xff, 0x00, 0xff, 0x00, 0x0b,
-	0xff, 0x0b, 0x87, 0xff, 0x89, 0x00, 0xff, 0x00, 0x00, 0xf9, 0x00, 0x00, 0xe3, 0x01, 0x00, 0xf4,
-	0x00, 0x00, 0xf5, 0x00, 0x00, 0x06, 0xf1, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff,
-	0x00, 0x00, 0xff, 0xe8, 0x96, 0x00, 0xe8, 0x96, 0x00, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00,
-	0x00, 0xff, 0xe8, 0x96, 0x00, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0xeb, 0xee, 0xff, 0xaa, 0xad,
-	0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0xe8, 0x96, 0x00, 0xe8, 0x96, 0x00,
-	0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00,
-	0x00, 0xff, 0xe8, 0x96, 0x00, 0xe8, 0x96, 0x00, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00,
-	0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x08, 0xff, 0x08, 0x5e, 0xff, 0x60, 0x00, 0xff, 0x00,
-	0x00, 0xfb, 0x00, 0x00, 0xe6, 0x01, 0x00, 0xee, 0x00, 0x00, 0x08, 0xeb, 0x00, 0x00, 0xff, 0x00,
-	0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0xe8, 0x96, 0x00, 0xe8, 0x96,
-	0x00, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0xe8, 0x96, 0x00, 0xe8, 0x96, 0x00,
-	0x00, 0x00, 0xff, 0x81, 0x83, 0xff, 0x49, 0x4a, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0xe8,
-	0x96, 0x00, 0xe8, 0x96, 0x00, 0xe8, 0x96, 0x00, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00,
-	0xff, 0x00, 0x00, 0xff, 0xe8, 0x96, 0x00, 0xe8, 0x96, 0x00, 0xe8, 0x96, 0x00, 0x00, 0x00, 0xff,
-	0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0xe8, 0x96, 0x00, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00,
-	0x00, 0xff, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x0d, 0xfe, 0x0d, 0x5a, 0xc0, 0x5d, 0x00, 0x01,
-	0xfd, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff,
-	0x00, 0x00, 0xff, 0xe8, 0x96, 0x00, 0xe8, 0x96, 0x00, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00,
-	0x00, 0xff, 0xe8, 0x96, 0x00, 0xe8, 0x96, 0x00, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00,
-	0xff, 0xe8, 0x96, 0x00, 0xe8, 0x96, 0x00, 0xe8, 0x96, 0x00, 0xe8, 0x96, 0x00, 0x00, 0x00, 0xff,
-	0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0xe8, 0x96, 0x00, 0xe8, 0x96, 0x00, 0xe8,
-	0x96, 0x00, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0xe8, 0x96,
-	0x00, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00,
-	0x06, 0xff, 0x06, 0x19, 0x99, 0x1c, 0x00, 0xfe, 0x00, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00,
-	0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0xe8, 0x96, 0x00, 0xe8, 0x96,
-	0x00, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0xe8, 0x96, 0x00, 0xe8, 0x96, 0x00,
-	0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0xe8, 0x96, 0x00, 0xe8, 0x96, 0x00, 0x00, 0x00, 0xff, 0x00,
-	0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0xe8, 0x96,
-	0x00, 0xe8, 0x96, 0x00, 0xe8, 0x96, 0x00, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff,
-	0x00, 0x00, 0xff, 0xe8, 0x96, 0x00, 0xe8, 0x96, 0x00, 0xe8, 0x96, 0x00, 0x00, 0x00, 0xff, 0x00,
-	0xff, 0x00, 0x06, 0xff, 0x06, 0x4d, 0xff, 0x4e, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0x00,
-	0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0xbc, 0xbf, 0xff, 0xbc, 0xbf, 0xff, 0x00, 0x00, 0xff,
-	0x00, 0x00, 0xff, 0xe8, 0x96, 0x00, 0xe8, 0x96, 0x00, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00,
-	0x00, 0xff, 0xe8, 0x96, 0x00, 0xe8, 0x96, 0x00, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0xe8, 0x96,
-	0x00, 0xe8, 0x96, 0x00, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff,
-	0x00, 0x00, 0xff, 0x21, 0x21, 0xff, 0xec, 0xa9, 0x30, 0xe8, 0x96, 0x00, 0xe8, 0x96, 0x00, 0x00,
-	0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0xe8, 0x96, 0x00, 0xe8, 0x96,
-	0x00, 0xe8, 0x96, 0x00, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x0d, 0xff, 0x0d, 0x99, 0xff, 0x9b,
-	0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00,
-	0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0xe8, 0x96, 0x00, 0xe8, 0x96,
-	0x00, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0xe8, 0x96, 0x00, 0xe8, 0x96, 0x00, 0x00, 0x00, 0xff,
-	0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0xe8, 0x96, 0x00, 0xe8, 0x96, 0x00, 0xe8, 0x96, 0x00, 0xe8,
-	0x96, 0x00, 0xe8, 0x96, 0x00, 0xe8, 0x96, 0x00, 0x00, 0x00, 0xff, 0x8e, 0x90, 0xff, 0xf6, 0xe3,
-	0xbb, 0xe8, 0x96, 0x00, 0xe8, 0x96, 0x00, 0xe8, 0x96, 0x00, 0xe8, 0x96, 0x00, 0xe8, 0x96, 0x00,
-	0x00, 0x00, 0xff, 0xe8, 0x96, 0x00, 0xe8, 0x96, 0x00, 0xe8, 0x96, 0x00, 0x00, 0x00, 0xff, 0x00,
-	0x00, 0xff, 0x00, 0xfe, 0x5b, 0x00, 0xfc, 0xe8, 0x00, 0xfd, 0x43, 0x00, 0x00, 0xff, 0x00, 0x00,
-	0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff,
-	0x00, 0x00, 0xff, 0xe8, 0x96, 0x00, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00,
-	0x00, 0xff, 0x6e, 0x70, 0xff, 0x28, 0x28, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00,
-	0xff, 0xe8, 0x96, 0x00, 0xe8, 0x96, 0x00, 0xe8, 0x96, 0x00, 0xe8, 0x96, 0x00, 0x00, 0x00, 0xff,
-	0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0xe8, 0x96, 0x00, 0xe8, 0x96, 0x00, 0xe8,
-	0x96, 0x00, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0xe8, 0x96,
-	0x00, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0xd7, 0xff, 0x00, 0xff, 0xff,
-	0x00, 0xc9, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x0c,
-	0x0c, 0xff, 0x40, 0x41, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00,
-	0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0xbb, 0xbe, 0xff, 0x4a, 0x4b, 0xff,
-	0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00,
-	0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00,
-	0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff,
-	0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x82, 0x84, 0xff, 0x0e,
-	0x0e, 0xff, 0x00, 0x32, 0xff, 0x00, 0xb2, 0xff, 0x00, 0x2b, 0xff, 0x00, 0x00, 0xff, 0x9d, 0xa0,
-	0xff, 0x57, 0x59, 0xff, 0x00, 0x00, 0xff, 0x3e, 0x3f, 0xff, 0xe3, 0xe7, 0xff, 0x00, 0x00, 0xff,
-	0x78, 0x7a, 0xff, 0x9d, 0xa0, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00,
-	0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00,
-	0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff,
-	0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00,
-	0x00, 0xff, 0x90, 0x93, 0xff, 0x70, 0x72, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00,
-	0xff, 0x00, 0x00, 0xff, 0xd4, 0xd7, 0xff, 0x19, 0x19, 0xff, 0x00, 0x00, 0xff, 0x9d, 0xa0, 0xff,
-	0x57, 0x59, 0xff, 0x00, 0x00, 0xff, 0x76, 0x77, 0xff, 0x40, 0x41, 0xff, 0x00, 0x00, 0xff, 0x00,
-	0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x3f, 0x41, 0xff, 0x57, 0x59, 0xff, 0x00, 0x00,
-	0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff,
-	0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x98,
-	0x9a, 0xff, 0xe3, 0xe6, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00,
-	0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0xd7, 0xda, 0xff, 0xb5, 0xb9, 0xff,
-	0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00,
-	0x00, 0xff, 0x00, 0x00, 0xff, 0x76, 0x77, 0xff, 0x40, 0x41, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00,
-	0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff,
-	0x00, 0x00
-};
-// End of Block 1
-
-const u08 block2[] PROGMEM = {
-	0xe4, 0xe7, 0xff, 0xe3, 0xe7, 0xff, 0xe0, 0xe4, 0xff, 0xe1, 0xe5, 0xff, 0xe2, 0xe6, 0xff, 0xe4,
-	0xe7, 0xff, 0xe6, 0xea, 0xff, 0xe7, 0xeb, 0xff, 0xe3, 0xe7, 0xff, 0xdf, 0xe2, 0xff, 0xe1, 0xe5,
-	0xff, 0xe1, 0xe4, 0xff, 0xd6, 0xda, 0xff, 0xcd, 0xd0, 0xff, 0xc7, 0xca, 0xff, 0xc4, 0xc7, 0xff,
-	0xe0, 0xe4, 0xff, 0xdf, 0xe2, 0xff, 0xd7, 0xdb, 0xff, 0xde, 0xe2, 0xff, 0xdc, 0xdf, 0xff, 0xc7,
-	0xc9, 0xff, 0xc0, 0xc3, 0xff, 0xc1, 0xc4, 0xff, 0xc8, 0xcb, 0xff, 0xd2, 0xd6, 0xff, 0xe8, 0xeb,
-	0xff, 0xf5, 0xf9, 0xff, 0xfa, 0xfe, 0xff, 0xfb, 0xfe, 0xff, 0xf8, 0xfc, 0xff, 0xe8, 0xec, 0xff,
-	0xdf, 0xe2, 0xff, 0xf9, 0xfd, 0xff, 0xf7, 0xfb, 0xff, 0xf7, 0xfb, 0xff, 0xf6, 0xfa, 0xff, 0xf2,
-	0xf6, 0xff, 0xf3, 0xf7, 0xff, 0xe3, 0xe7, 0xff, 0xf0, 0xf4, 0xff, 0xd5, 0xd9, 0xff, 0xe6, 0xe9,
-	0xff, 0xec, 0xf0, 0xff, 0xef, 0xf2, 0xff, 0xf1, 0xf5, 0xff, 0xee, 0xf2, 0xff, 0xed, 0xf1, 0xff,
-	0xec, 0xf0, 0xff, 0xe6, 0xea, 0xff, 0xb9, 0xbc, 0xff, 0xbb, 0xbe, 0xff, 0xbd, 0xc0, 0xff, 0xaa,
-	0xac, 0xff, 0xb8, 0xba, 0xff, 0xc6, 0xc9, 0xff, 0xda, 0xdd, 0xff, 0xdb, 0xdf, 0xff, 0xd8, 0xdc,
-	0xff, 0xe6, 0xea, 0xff, 0xe0, 0xe4, 0xff, 0xdc, 0xdf, 0xff, 0xd0, 0xd3, 0xff, 0xb5, 0xb9, 0xff,
-	0xa9, 0xac, 0xff, 0xe5, 0xe8, 0xff, 0xd4, 0xd8, 0xff, 0xb4, 0xb7, 0xff, 0xd3, 0xd6, 0xff, 0x9e,
-	0xa0, 0xff, 0x4b, 0x4d, 0xff, 0x6f, 0x71, 0xff, 0xa4, 0xa7, 0xff, 0xa0, 0xa2, 0xff, 0x7f, 0x81,
-	0xff, 0x9d, 0x9f, 0xff, 0xbd, 0xc0, 0xff, 0xec, 0xee, 0xff, 0xf8, 0xf9, 0xff, 0xcc, 0xce, 0xff,
-	0xed, 0xf1, 0xff, 0xed, 0xf1, 0xff, 0xb2, 0xb4, 0xff, 0x4d, 0x4e, 0xff, 0x21, 0x22, 0xff, 0x05,
-	0x05, 0xff, 0x3c, 0x3d, 0xff, 0x7e, 0x80, 0xff, 0xaa, 0xad, 0xff, 0xd9, 0xdb, 0xff, 0xfb, 0xfe,
-	0xff, 0xf6, 0xfa, 0xff, 0xef, 0xf3, 0xff, 0xf7, 0xfb, 0xff, 0xf7, 0xfb, 0xff, 0xfa, 0xfe, 0xff,
-	0xfb, 0xff, 0xff, 0xf5, 0xf9, 0xff, 0xe2, 0xe6, 0xff, 0xdb, 0xde, 0xff, 0xe3, 0xe6, 0xff, 0xeb,
-	0xef, 0xff, 0xe9, 0xed, 0xff, 0xe8, 0xec, 0xff, 0xf5, 0xf9, 0xff, 0xbd, 0xc0, 0xff, 0xab, 0xae,
-	0xff, 0xaf, 0xb2, 0xff, 0xbf, 0xc2, 0xff, 0xb2, 0xb4, 0xff, 0x0a, 0x0a, 0xff, 0x11, 0x43, 0x78,
-	0x11, 0x43, 0x78, 0x11, 0x43, 0x78, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x06, 0x06, 0xff, 0xc9,
-	0xc9, 0xff, 0xe0, 0xe0, 0xff, 0x23, 0x23, 0xff, 0x00, 0x00, 0xff, 0x43, 0x44, 0xff, 0xc3, 0xc6,
-	0xff, 0xe0, 0xe2, 0xff, 0xce, 0xd1, 0xff, 0xde, 0xe2, 0xff, 0xb4, 0xb7, 0xff, 0x74, 0x76, 0xff,
-	0x4f, 0x50, 0xff, 0xef, 0xef, 0xff, 0xfb, 0xfb, 0xff, 0xaf, 0xb1, 0xff, 0x26, 0x27, 0xff, 0x01,
-	0x01, 0xff, 0x7b, 0x7d, 0xff, 0xd6, 0xd7, 0xff, 0x92, 0x93, 0xff, 0x9e, 0xa0, 0xff, 0x33, 0x34,
-	0xff, 0x3d, 0x3e, 0xff, 0xca, 0xca, 0xff, 0xd6, 0xd6, 0xff, 0x43, 0x43, 0xff, 0x32, 0x33, 0xff,
-	0xd9, 0xdc, 0xff, 0x26, 0x27, 0xff, 0x25, 0x26, 0xff, 0x21, 0x22, 0xff, 0x0e, 0x0e, 0xff, 0x00,
-	0x00, 0xff, 0x00, 0x00, 0xff, 0x11, 0x43, 0x78, 0x11, 0x43, 0x78, 0x11, 0x43, 0x78, 0x00, 0x00,
-	0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x57, 0x59, 0xff, 0xf4, 0xf8, 0xff, 0x00, 0x00, 0xff,
-	0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x14, 0x14, 0xff, 0xd6, 0xd7, 0xff, 0xc5, 0xc5, 0xff, 0x14,
-	0x14, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x19, 0x19, 0xff, 0xdd, 0xdd, 0xff, 0xc0, 0xc1,
-	0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x7d, 0x7d, 0xff, 0xd4, 0xd5, 0xff,
-	0xd5, 0xd6, 0xff, 0x5b, 0x5c, 0xff, 0x04, 0x04, 0xff, 0x00, 0x00, 0xff, 0x4a, 0x4b, 0xff, 0xf4,
-	0xf8, 0xff, 0x01, 0x01, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00,
-	0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x11, 0x43, 0x78,
-	0x11, 0x43, 0x78, 0x11, 0x43, 0x78, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x12,
-	0x12, 0xff, 0x57, 0x59, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00,
-	0xff, 0x47, 0x47, 0xff, 0xff, 0xff, 0xff, 0x00, 0x00, 0xff, 0x21, 0x21, 0xff, 0xfe, 0xfe, 0xff,
-	0x00, 0x00, 0xff, 0x42, 0x42, 0xff, 0x2d, 0x2d, 0xff, 0x4c, 0x4d, 0xff, 0x21, 0x22, 0xff, 0x00,
-	0x00, 0xff, 0x1e, 0x1e, 0xff, 0x52, 0x53, 0xff, 0x82, 0x84, 0xff, 0x67, 0x69, 0xff, 0x00, 0x00,
-	0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff,
-	0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0xec, 0x01, 0x00, 0xef, 0x01, 0x00,
-	0xef, 0x00, 0x00, 0xfe, 0x00, 0x00, 0xbd, 0x02, 0x0c, 0x4e, 0x54, 0x11, 0x43, 0x78, 0x00, 0x00,
-	0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff,
-	0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x33, 0x34, 0xff, 0x9d, 0x9f, 0xff, 0x00,
-	0x00, 0xff, 0x08, 0x08, 0xff, 0x68, 0x68, 0xff, 0x00, 0x00, 0xff, 0x29, 0x2a, 0xff, 0x0b, 0x0b,
-	0xff, 0x13, 0x13, 0xff, 0x03, 0x03, 0xff, 0x06, 0x06, 0xff, 0x02, 0x02, 0xff, 0x02, 0x02, 0xff,
-	0x0a, 0x0a, 0xff, 0x1e, 0x1e, 0xff, 0x0b, 0x0b, 0xff, 0x12, 0x13, 0xff, 0x00, 0x00, 0xff, 0x00,
-	0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x62, 0x62, 0xff, 0x03, 0x03,
-	0xff, 0x00, 0x00, 0xfe, 0x00, 0xf8, 0x00, 0x00, 0xe2, 0x01, 0x00, 0xd5, 0x02, 0x00, 0xd4, 0x01,
-	0x00, 0xdd, 0x01, 0x00, 0xb6, 0x02, 0x00, 0x96, 0x03, 0x00, 0xc5, 0x02, 0x00, 0x09, 0xe8, 0x00,
-	0x07, 0xed, 0x00, 0x00, 0xff, 0x46, 0x46, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00,
-	0xff, 0x0a, 0x0a, 0xff, 0x1f, 0x1f, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff,
-	0x07, 0x07, 0xff, 0xde, 0xe2, 0xff, 0x00, 0x00, 0xff, 0x20, 0x21, 0xff, 0x2c, 0x2d, 0xff, 0x10,
-	0x11, 0xff, 0x12, 0x12, 0xff, 0x3f, 0x41, 0xff, 0x04, 0x04, 0xff, 0x1e, 0x1f, 0xff, 0x15, 0x15,
-	0xff, 0x1d, 0x1e, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff,
-	0x00, 0x00, 0xff, 0xb4, 0xb4, 0xff, 0x5f, 0x5f, 0xff, 0x00, 0x00, 0xff, 0x00, 0xff, 0x00, 0x23,
-	0xff, 0x24, 0x6b, 0xfc, 0x6d, 0x00, 0xea, 0x00, 0x00, 0xd4, 0x01, 0x00, 0x9f, 0x03, 0x4e, 0xb9,
-	0x4f, 0x28, 0xc9, 0x2a, 0x00, 0xc3, 0x02, 0x00, 0xb3, 0x02, 0x09, 0x09, 0xff, 0xaf, 0xaf, 0xff,
-	0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00,
-	0x00, 0xff, 0x14, 0x14, 0xff, 0x12, 0x12, 0xff, 0x0b, 0x0b, 0xff, 0x91, 0x93, 0xff, 0x00, 0x00,
-	0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x03, 0x03, 0xff, 0x15, 0x16, 0xff,
-	0x26, 0x26, 0xff, 0x3c, 0x3d, 0xff, 0x1e, 0x1e, 0xff, 0x17, 0x17, 0xff, 0x00, 0x00, 0xff, 0x00,
-	0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x25, 0x25, 0xff, 0x2a, 0x2a,
-	0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x1a, 0xff, 0x1a, 0x4e, 0xff, 0x4f, 0x00, 0xff, 0x00,
-	0x00, 0xde, 0x01, 0x00, 0xe2, 0x00, 0x58, 0xe4, 0x59, 0x2e, 0xc2, 0x2f, 0x00, 0xc9, 0x01, 0x00,
-	0x0d, 0xe1, 0x0d, 0x0d, 0xff, 0x89, 0x89, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0xe8, 0x96,
-	0x00, 0xe8, 0x96, 0x00, 0xe8, 0x96, 0x00, 0xe8, 0x96, 0x00, 0x1e, 0x1f, 0xff, 0x0c, 0x0c, 0xff,
-	0x00, 0x00, 0xff, 0x5a, 0x5a, 0xff, 0x15, 0x15, 0xff, 0xe8, 0x96, 0x00, 0xe8, 0x96, 0x00, 0x00,
-	0x00, 0xff, 0x0a, 0x0a, 0xff, 0x35, 0x36, 0xff, 0x3c, 0x3d, 0xff, 0x63, 0x65, 0xff, 0xe8, 0x96,
-	0x00, 0xe8, 0x96, 0x00, 0xe8, 0x96, 0x00, 0xe8, 0x96, 0x00, 0xe8, 0x96, 0x00, 0x00, 0x00, 0xff,
-	0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0xe8, 0x96, 0x00, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00,
-	0xff, 0x00, 0x06, 0xff, 0x06, 0x08, 0xff, 0x08, 0x00, 0xf3, 0x00, 0x0b, 0xe6, 0x0b, 0x4e, 0xb5,
-	0x52, 0x00, 0x0d, 0xdf, 0x00, 0x05, 0xf0, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x1b, 0x1c, 0xff,
-	0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0xe8, 0x96, 0x00, 0xe8, 0x96, 0x00, 0xe8, 0x96, 0x00, 0xe8,
-	0x96, 0x00, 0xe8, 0x96, 0x00, 0x00, 0x00, 0xff, 0x0b, 0x0b, 0xff, 0xa5, 0xa5, 0xff, 0xc9, 0x8a,
-	0x3a, 0xe8, 0x96, 0x00, 0xe8, 0x96, 0x00, 0xe8, 0x96, 0x00, 0xe8, 0x96, 0x00, 0x37, 0x38, 0xff,
-	0x27, 0x28, 0xff, 0xe3, 0x94, 0x0c, 0xe8, 0x96, 0x00, 0xe8, 0x96, 0x00, 0xe8, 0x96, 0x00, 0xe8,
-	0x96, 0x00, 0xe8, 0x96, 0x00, 0xe8, 0x96, 0x00, 0x00, 0x00, 0xff, 0xe8, 0x96, 0x00, 0xe8, 0x96,
-	0x00, 0xe6, 0x95, 0x02, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x66, 0xff, 0x66, 0x90, 0xff, 0x90,
-	0x00, 0xf7, 0x00, 0x04, 0xe2, 0x06, 0x1c, 0xa0, 0x1f, 0x00, 0x9d, 0x03, 0x00, 0xe0, 0x01, 0x00,
-	0x00, 0xff, 0x00, 0x00, 0xff, 0x1c, 0x1d, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0xe8, 0x96,
-	0x00, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0xe8, 0x96, 0x00, 0xe8, 0x96, 0x00, 0x00, 0x00, 0xff,
-	0x0b, 0x0b, 0xff, 0x2e, 0x2e, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0xe8,
-	0x96, 0x00, 0xe8, 0x96, 0x00, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00,
-	0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0xe8, 0x96, 0x00, 0xe8, 0x96, 0x00, 0xe8, 0x96, 0x00,
-	0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0xe8, 0x96, 0x00, 0x11, 0x0c, 0xeb, 0x00, 0xff, 0x00, 0x0b,
-	0xff, 0x0b, 0xbf, 0xff, 0xc0, 0x77, 0xff, 0x77, 0x00, 0xf9, 0x00, 0x00, 0xe3, 0x01, 0x00, 0xf4,
-	0x00, 0x00, 0xf5, 0x00, 0x00, 0x06, 0xf1, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff,
-	0x00, 0x00, 0xff, 0xe8, 0x96, 0x00, 0xe8, 0x96, 0x00, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00,
-	0x00, 0xff, 0xe8, 0x96, 0x00, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x18, 0x19, 0xff, 0x0c, 0x0c,
-	0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0xe8, 0x96, 0x00, 0xe8, 0x96, 0x00,
-	0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00,
-	0x00, 0xff, 0xe8, 0x96, 0x00, 0xe8, 0x96, 0x00, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00,
-	0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x08, 0xff, 0x08, 0x5e, 0xff, 0x60, 0x00, 0xff, 0x00,
-	0x00, 0xfb, 0x00, 0x00, 0xe6, 0x01, 0x00, 0xee, 0x00, 0x00, 0x08, 0xeb, 0x00, 0x00, 0xff, 0x07,
-	0x07, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0xe8, 0x96, 0x00, 0xe8, 0x96,
-	0x00, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0xe8, 0x96, 0x00, 0xe8, 0x96, 0x00,
-	0x00, 0x00, 0xff, 0x4d, 0x4e, 0xff, 0x2b, 0x2c, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0xe8,
-	0x96, 0x00, 0xe8, 0x96, 0x00, 0xe8, 0x96, 0x00, 0x00, 0x00, 0xff, 0x67, 0x67, 0xff, 0x24, 0x24,
-	0xff, 0x00, 0x00, 0xff, 0xe8, 0x96, 0x00, 0xe8, 0x96, 0x00, 0xe8, 0x96, 0x00, 0x00, 0x00, 0xff,
-	0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0xe8, 0x96, 0x00, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00,
-	0x00, 0xff, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x0d, 0xfe, 0x0d, 0x5a, 0xc0, 0x5d, 0x00, 0x01,
-	0xfd, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0xe7, 0xe7, 0xff, 0x0e, 0x0e, 0xff, 0x00, 0x00, 0xff,
-	0x00, 0x00, 0xff, 0xe8, 0x96, 0x00, 0xe8, 0x96, 0x00, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00,
-	0x00, 0xff, 0xe8, 0x96, 0x00, 0xe8, 0x96, 0x00, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00,
-	0xff, 0xe8, 0x96, 0x00, 0xe8, 0x96, 0x00, 0xe8, 0x96, 0x00, 0xe8, 0x96, 0x00, 0x00, 0x00, 0xff,
-	0x00, 0x00, 0xff, 0x88, 0x88, 0xff, 0xd9, 0xd9, 0xff, 0xe8, 0x96, 0x00, 0xe8, 0x96, 0x00, 0xe8,
-	0x96, 0x00, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0xe8, 0x96,
-	0x00, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00,
-	0x06, 0xff, 0x06, 0x19, 0x99, 0x1c, 0x00, 0xfe, 0x00, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00,
-	0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0xe8, 0x96, 0x00, 0xe8, 0x96,
-	0x00, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0xe8, 0x96, 0x00, 0xe8, 0x96, 0x00,
-	0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0xe8, 0x96, 0x00, 0xe8, 0x96, 0x00, 0x00, 0x00, 0xff, 0xfe,
-	0xfe, 0xff, 0xbc, 0xbc, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0xe8, 0x96,
-	0x00, 0xe8, 0x96, 0x00, 0xe8, 0x96, 0x00, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff,
-	0x00, 0x00, 0xff, 0xe8, 0x96, 0x00, 0xe8, 0x96, 0x00, 0xe8, 0x96, 0x00, 0x00, 0x00, 0xff, 0x00,
-	0xff, 0x00, 0x1c, 0xff, 0x1c, 0xe8, 0xff, 0xe8, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0x00,
-	0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x70, 0x72, 0xff, 0x7a, 0x7c, 0xff, 0x00, 0x00, 0xff,
-	0x00, 0x00, 0xff, 0xe8, 0x96, 0x00, 0xe8, 0x96, 0x00, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00,
-	0x00, 0xff, 0xe8, 0x96, 0x00, 0xe8, 0x96, 0x00, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0xe8, 0x96,
-	0x00, 0xe8, 0x96, 0x00, 0x00, 0x00, 0xff, 0x04, 0x04, 0xff, 0x1a, 0x1a, 0xff, 0x00, 0x00, 0xff,
-	0x00, 0x00, 0xff, 0x21, 0x21, 0xff, 0xec, 0xa9, 0x30, 0xe8, 0x96, 0x00, 0xe8, 0x96, 0x00, 0x00,
-	0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0xe8, 0x96, 0x00, 0xe8, 0x96,
-	0x00, 0xe8, 0x96, 0x00, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x16, 0xff, 0x16, 0xcb, 0xff, 0xcc,
-	0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x1b, 0x1b, 0xff, 0x03, 0x03, 0xff, 0x00, 0x00, 0xff, 0x00,
-	0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x74, 0x74, 0xff, 0xe8, 0x97, 0x03, 0xe8, 0x96,
-	0x00, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0xe8, 0x96, 0x00, 0xe8, 0x96, 0x00, 0x00, 0x00, 0xff,
-	0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0xe8, 0x96, 0x00, 0xe8, 0x96, 0x00, 0xe8, 0x96, 0x00, 0xe8,
-	0x96, 0x00, 0xe8, 0x96, 0x00, 0xe8, 0x96, 0x00, 0x00, 0x00, 0xff, 0x05, 0x05, 0xff, 0x4f, 0x49,
-	0xe9, 0xe8, 0x96, 0x00, 0xe8, 0x96, 0x00, 0xe8, 0x96, 0x00, 0xe8, 0x96, 0x00, 0xe8, 0x96, 0x00,
-	0x00, 0x00, 0xff, 0xe8, 0x96, 0x00, 0xe8, 0x96, 0x00, 0xe8, 0x96, 0x00, 0x5c, 0x5c, 0xff, 0x02,
-	0x02, 0xff, 0x00, 0xff, 0x95, 0x00, 0xff, 0xff, 0x00, 0xff, 0x89, 0x00, 0x00, 0xff, 0xf5, 0xf5,
-	0xff, 0x47, 0x47, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff,
-	0xba, 0xba, 0xff, 0xe9, 0x9c, 0x0e, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00,
-	0x00, 0xff, 0x19, 0x19, 0xff, 0x19, 0x19, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00,
-	0xff, 0xe8, 0x96, 0x00, 0xe8, 0x96, 0x00, 0xea, 0xa1, 0x1b, 0xe8, 0x97, 0x02, 0x00, 0x00, 0xff,
-	0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0xe8, 0x96, 0x00, 0xe8, 0x96, 0x00, 0xe8,
-	0x96, 0x00, 0x8c, 0x8c, 0xff, 0x28, 0x28, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0xe8, 0x96,
-	0x00, 0x00, 0x00, 0xff, 0x9a, 0x9a, 0xff, 0x04, 0x04, 0xff, 0x00, 0xd8, 0xff, 0x00, 0xff, 0xff,
-	0x0b, 0xde, 0xff, 0x00, 0x00, 0xff, 0x1b, 0x1b, 0xff, 0x03, 0x03, 0xff, 0x00, 0x00, 0xff, 0x0b,
-	0x0b, 0xff, 0x32, 0x33, 0xff, 0x00, 0x00, 0xff, 0x61, 0x61, 0xff, 0x0a, 0x0a, 0xff, 0x00, 0x00,
-	0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x04, 0x04, 0xff, 0x00, 0x00, 0xff,
-	0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0xcd,
-	0xcd, 0xff, 0xe3, 0xe3, 0xff, 0x0e, 0x0e, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00,
-	0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x28, 0x28, 0xff, 0xcf, 0xcf, 0xff, 0xc4, 0xc4, 0xff,
-	0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x53, 0x54, 0xff, 0x0e,
-	0x0e, 0xff, 0x2f, 0x53, 0xff, 0x04, 0xd1, 0xff, 0x01, 0x2b, 0xff, 0x00, 0x00, 0xff, 0x14, 0x15,
-	0xff, 0x0f, 0x0f, 0xff, 0x00, 0x00, 0xff, 0x06, 0x06, 0xff, 0x06, 0x06, 0xff, 0x00, 0x00, 0xff,
-	0x02, 0x02, 0xff, 0x0a, 0x0b, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x13, 0x13, 0xff, 0x38,
-	0x38, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00,
-	0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x0b, 0x0b, 0xff, 0x00, 0x00, 0xff,
-	0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x04, 0x04, 0xff, 0x13, 0x13, 0xff, 0x00, 0x00, 0xff, 0x05,
-	0x05, 0xff, 0x25, 0x26, 0xff, 0x61, 0x63, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00,
-	0xff, 0x00, 0x00, 0xff, 0x12, 0x13, 0xff, 0x12, 0x12, 0xff, 0x00, 0x00, 0xff, 0x06, 0x06, 0xff,
-	0x15, 0x16, 0xff, 0x12, 0x12, 0xff, 0x1a, 0x1a, 0xff, 0x09, 0x09, 0xff, 0x00, 0x00, 0xff, 0x00,
-	0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x26, 0x27, 0xff, 0x17, 0x17, 0xff, 0x00, 0x00,
-	0xff, 0x00, 0x00, 0xff, 0xa0, 0xa0, 0xff, 0xcf, 0xcf, 0xff, 0x90, 0x90, 0xff, 0x00, 0x00, 0xff,
-	0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x14,
-	0x14, 0xff, 0x15, 0x15, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x25, 0x25, 0xff, 0xd7, 0xd7,
-	0xff, 0xbf, 0xbf, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x05, 0x05, 0xff, 0x5d, 0x5f, 0xff,
-	0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00,
-	0x00, 0xff, 0x00, 0x00, 0xff, 0x0b, 0x0b, 0xff, 0x88, 0x88, 0xff, 0xbb, 0xbb, 0xff, 0x55, 0x55,
-	0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff,
-	0x00, 0x00
+const cmdEntry cmdsMain[] PROGMEM = {
+  { 'A', CMDARG_NUM,  0xFF,       errBadAddr,   handleAddr },
+  { 'L', CMDARG_NUM,  255,        errBadLevel,  handleLevel },
+  { 'D', CMDARG_NUM,  0xFFFFFFFF, NULL,         handleDither },
+  { 'P', CMDARG_NUM,  0xFFFF,     errBadBudget, handlePower },
+  { 'U', CMDARG_NUM,  0xFFFFFFFF, NULL,         handleBaud },
+  { 'B', CMDARG_REST, 0,          NULL,         handleString },
+  { 'M', CMDARG_NUM,  0xFFFF,     errBadPeriod, handleMarquee },
+  { 'S', CMDARG_NUM,  0xFFFF,     errBadPeriod, handleSlideshow },
+  { 'F', CMDARG_NONE, 0,          NULL,         handleStream },
+  { 'C', CMDARG_NONE, 0,          NULL,         handleChunk },
+  { 'G', CMDARG_NONE, 0,          NULL,         handleGet },
 };
-// End of Block 2
-
-const u08 block3[] PROGMEM = {
-	0xe4, 0xe7, 0xff, 0xe3, 0xe7, 0xff, 0xe0, 0xe4, 0xff, 0xe1, 0xe5, 0xff, 0xe2, 0xe6, 0xff, 0xe4,
-	0xe7, 0xff, 0xe6, 0xea, 0xff, 0xe7, 0xeb, 0xff, 0xe3, 0xe7, 0xff, 0xdf, 0xe2, 0xff, 0xe1, 0xe5,
-	0xff, 0xe1, 0xe4, 0xff, 0xd6, 0xda, 0xff, 0xcd, 0xd0, 0xff, 0xc7, 0xca, 0xff, 0xc4, 0xc7, 0xff,
-	0xe0, 0xe4, 0xff, 0xdf, 0xe2, 0xff, 0xd7, 0xdb, 0xff, 0xde, 0xe2, 0xff, 0xdc, 0xdf, 0xff, 0xc7,
-	0xc9, 0xff, 0xc0, 0xc3, 0xff, 0xc1, 0xc4, 0xff, 0xc8, 0xcb, 0xff, 0xd2, 0xd6, 0xff, 0xe8, 0xeb,
-	0xff, 0xf5, 0xf9, 0xff, 0xfa, 0xfe, 0xff, 0xfb, 0xfe, 0xff, 0xf8, 0xfc, 0xff, 0xe8, 0xec, 0xff,
-	0xdf, 0xe2, 0xff, 0xf9, 0xfd, 0xff, 0xf7, 0xfb, 0xff, 0xf7, 0xfb, 0xff, 0xf6, 0xfa, 0xff, 0xf2,
-	0xf6, 0xff, 0xf3, 0xf7, 0xff, 0xe3, 0xe7, 0xff, 0xf0, 0xf4, 0xff, 0xd5, 0xd9, 0xff, 0xe8, 0xeb,
-	0xff, 0xef, 0xf3, 0xff, 0xf2, 0xf4, 0xff, 0xf3, 0xf7, 0xff, 0xf0, 0xf3, 0xff, 0xed, 0xf1, 0xff,
-	0xec, 0xf0, 0xff, 0xe6, 0xea, 0xff, 0xb9, 0xbc, 0xff, 0xbb, 0xbe, 0xff, 0xbd, 0xc0, 0xff, 0xaa,
-	0xac, 0xff, 0xb8, 0xba, 0xff, 0xc6, 0xc9, 0xff, 0xda, 0xdd, 0xff, 0xdb, 0xdf, 0xff, 0xd8, 0xdc,
-	0xff, 0xe6, 0xea, 0xff, 0xe0, 0xe4, 0xff, 0xdc, 0xdf, 0xff, 0xd0, 0xd3, 0xff, 0xb5, 0xb9, 0xff,
-	0xa9, 0xac, 0xff, 0xe5, 0xe8, 0xff, 0xd4, 0xd8, 0xff, 0xb4, 0xb7, 0xff, 0xd3, 0xd6, 0xff, 0x9e,
-	0xa0, 0xff, 0x4b, 0x4d, 0xff, 0x6f, 0x71, 0xff, 0xa4, 0xa7, 0xff, 0xa0, 0xa2, 0xff, 0x7f, 0x81,
-	0xff, 0x9d, 0x9f, 0xff, 0xbd, 0xc0, 0xff, 0xec, 0xee, 0xff, 0xf8, 0xf9, 0xff, 0xcc, 0xce, 0xff,
-	0xed, 0xf1, 0xff, 0xed, 0xf1, 0xff, 0xcb, 0xcc, 0xff, 0xc1, 0xc1, 0xff, 0xb3, 0xb4, 0xff, 0xac,
-	0xac, 0xff, 0x99, 0x9a, 0xff, 0xb7, 0xb8, 0xff, 0xb0, 0xb2, 0xff, 0xd9, 0xdb, 0xff, 0xfb, 0xfe,
-	0xff, 0xf9, 0xfc, 0xff, 0xf3, 0xf6, 0xff, 0xf7, 0xfb, 0xff, 0xf7, 0xfb, 0xff, 0xfa, 0xfe, 0xff,
-	0xfb, 0xff, 0xff, 0xf5, 0xf9, 0xff, 0xe2, 0xe6, 0xff, 0xdb, 0xde, 0xff, 0xe3, 0xe6, 0xff, 0xeb,
-	0xef, 0xff, 0xe9, 0xed, 0xff, 0xe8, 0xec, 0xff, 0xf5, 0xf9, 0xff, 0xbd, 0xc0, 0xff, 0xab, 0xae,
-	0xff, 0xaf, 0xb2, 0xff, 0xbf, 0xc2, 0xff, 0xb2, 0xb4, 0xff, 0x0a, 0x0a, 0xff, 0x11, 0x43, 0x78,
-	0x11, 0x43, 0x78, 0x11, 0x43, 0x78, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x06, 0x06, 0xff, 0xc9,
-	0xc9, 0xff, 0xe2, 0xe2, 0xff, 0xea, 0xea, 0xff, 0x00, 0x00, 0xff, 0x43, 0x44, 0xff, 0xc3, 0xc6,
-	0xff, 0xe0, 0xe2, 0xff, 0xce, 0xd1, 0xff, 0xde, 0xe2, 0xff, 0xb4, 0xb7, 0xff, 0xbd, 0xbe, 0xff,
-	0xc2, 0xc2, 0xff, 0xf1, 0xf1, 0xff, 0xfb, 0xfb, 0xff, 0xee, 0xee, 0xff, 0x5b, 0x5c, 0xff, 0x01,
-	0x01, 0xff, 0x7b, 0x7d, 0xff, 0xd6, 0xd7, 0xff, 0x92, 0x93, 0xff, 0x9e, 0xa0, 0xff, 0x33, 0x34,
-	0xff, 0x3d, 0x3e, 0xff, 0xca, 0xca, 0xff, 0xd6, 0xd6, 0xff, 0x43, 0x43, 0xff, 0x32, 0x33, 0xff,
-	0xd9, 0xdc, 0xff, 0x6c, 0x6c, 0xff, 0x33, 0x34, 0xff, 0x21, 0x22, 0xff, 0x0e, 0x0e, 0xff, 0x4f,
-	0x4f, 0xff, 0x66, 0x66, 0xff, 0x11, 0x43, 0x78, 0x11, 0x43, 0x78, 0x11, 0x43, 0x78, 0x00, 0x00,
-	0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x57, 0x59, 0xff, 0xf5, 0xf9, 0xff, 0xfa, 0xfa, 0xff,
-	0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x0f, 0x0f, 0xff, 0x92, 0x93, 0xff, 0xc5, 0xc5, 0xff, 0x14,
-	0x14, 0xff, 0x00, 0x00, 0xff, 0x0d, 0x0d, 0xff, 0x85, 0x85, 0xff, 0xed, 0xed, 0xff, 0xcf, 0xd0,
-	0xff, 0xc6, 0xc6, 0xff, 0x05, 0x05, 0xff, 0x00, 0x00, 0xff, 0x7d, 0x7d, 0xff, 0xd4, 0xd5, 0xff,
-	0xd5, 0xd6, 0xff, 0x5b, 0x5c, 0xff, 0x04, 0x04, 0xff, 0x00, 0x00, 0xff, 0x4a, 0x4b, 0xff, 0xf4,
-	0xf8, 0xff, 0x01, 0x01, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0xf2, 0xf2, 0xff, 0xfa, 0xfa,
-	0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x1f, 0x1f, 0xff, 0x28, 0x28, 0xff, 0x11, 0x43, 0x78,
-	0x11, 0x43, 0x78, 0x11, 0x43, 0x78, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x12,
-	0x12, 0xff, 0x57, 0x59, 0xff, 0xc1, 0xc1, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00,
-	0xff, 0x07, 0x07, 0xff, 0x37, 0x37, 0xff, 0x00, 0x00, 0xff, 0x11, 0x11, 0xff, 0x18, 0x18, 0xff,
-	0x00, 0x00, 0xff, 0xb6, 0xb6, 0xff, 0xc2, 0xc2, 0xff, 0x96, 0x96, 0xff, 0x21, 0x22, 0xff, 0x00,
-	0x00, 0xff, 0x1e, 0x1e, 0xff, 0x52, 0x53, 0xff, 0x82, 0x84, 0xff, 0x67, 0x69, 0xff, 0x00, 0x00,
-	0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff,
-	0x00, 0x00, 0xff, 0xcc, 0xcc, 0xff, 0xc1, 0xc1, 0xff, 0x00, 0xec, 0x01, 0x00, 0xef, 0x01, 0x00,
-	0xef, 0x00, 0x00, 0xfe, 0x00, 0x00, 0xbd, 0x02, 0x0c, 0x4e, 0x54, 0x11, 0x43, 0x78, 0x00, 0x00,
-	0xff, 0x00, 0x00, 0xff, 0x1f, 0x1f, 0xff, 0x15, 0x15, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff,
-	0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x27, 0x28, 0xff, 0x31, 0x32, 0xff, 0x00,
-	0x00, 0xff, 0x04, 0x04, 0xff, 0x1e, 0x1e, 0xff, 0x00, 0x00, 0xff, 0xbd, 0xbd, 0xff, 0x16, 0x16,
-	0xff, 0x13, 0x13, 0xff, 0x03, 0x03, 0xff, 0x06, 0x06, 0xff, 0x02, 0x02, 0xff, 0x02, 0x02, 0xff,
-	0x0a, 0x0a, 0xff, 0x1e, 0x1e, 0xff, 0x0b, 0x0b, 0xff, 0x12, 0x13, 0xff, 0x00, 0x00, 0xff, 0x00,
-	0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x23, 0x23, 0xff, 0x03, 0x03,
-	0xff, 0x00, 0x00, 0xfe, 0x00, 0xf8, 0x00, 0x00, 0xe2, 0x01, 0x00, 0xd5, 0x02, 0x00, 0xd4, 0x01,
-	0x00, 0xdd, 0x01, 0x00, 0xb6, 0x02, 0x00, 0x96, 0x03, 0x00, 0xc5, 0x02, 0xd6, 0xd7, 0xfb, 0xcd,
-	0xce, 0xfb, 0x00, 0x00, 0xff, 0x01, 0x01, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00,
-	0xff, 0x0a, 0x0a, 0xff, 0x1f, 0x1f, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff,
-	0x07, 0x07, 0xff, 0x28, 0x29, 0xff, 0x00, 0x00, 0xff, 0x20, 0x21, 0xff, 0x2c, 0x2d, 0xff, 0x10,
-	0x11, 0xff, 0x12, 0x12, 0xff, 0x3f, 0x41, 0xff, 0x04, 0x04, 0xff, 0x1e, 0x1f, 0xff, 0x47, 0x47,
-	0xff, 0x35, 0x36, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff,
-	0x00, 0x00, 0xff, 0x37, 0x37, 0xff, 0x33, 0x33, 0xff, 0x00, 0x00, 0xff, 0x00, 0xff, 0x00, 0x23,
-	0xff, 0x24, 0x6b, 0xfc, 0x6d, 0x00, 0xea, 0x00, 0x00, 0xd4, 0x01, 0x00, 0x9f, 0x03, 0x4e, 0xb9,
-	0x4f, 0x28, 0xc9, 0x2a, 0x00, 0xc3, 0x02, 0x00, 0xb3, 0x02, 0x09, 0x09, 0xff, 0x01, 0x01, 0xff,
-	0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00,
-	0x00, 0xff, 0x14, 0x14, 0xff, 0x12, 0x12, 0xff, 0x0b, 0x0b, 0xff, 0x17, 0x17, 0xff, 0x00, 0x00,
-	0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x03, 0x03, 0xff, 0x15, 0x16, 0xff,
-	0x26, 0x26, 0xff, 0x8b, 0x8b, 0xff, 0xb3, 0xb3, 0xff, 0x4c, 0x4c, 0xff, 0x00, 0x00, 0xff, 0x00,
-	0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x25, 0x25, 0xff, 0x2a, 0x2a,
-	0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x1a, 0xff, 0x1a, 0x4e, 0xff, 0x4f, 0x00, 0xff, 0x00,
-	0x00, 0xde, 0x01, 0x00, 0xe2, 0x00, 0x58, 0xe4, 0x59, 0x2e, 0xc2, 0x2f, 0x00, 0xc9, 0x01, 0x00,
-	0x0d, 0xe1, 0x09, 0x09, 0xff, 0x03, 0x03, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0xe8, 0x96,
-	0x00, 0xe8, 0x96, 0x00, 0xe8, 0x96, 0x00, 0xe8, 0x96, 0x00, 0x1e, 0x1f, 0xff, 0x0c, 0x0c, 0xff,
-	0x00, 0x00, 0xff, 0x0e, 0x0e, 0xff, 0x15, 0x15, 0xff, 0xe8, 0x96, 0x00, 0xe8, 0x96, 0x00, 0x00,
-	0x00, 0xff, 0x0a, 0x0a, 0xff, 0x35, 0x36, 0xff, 0x3c, 0x3d, 0xff, 0xfb, 0xfb, 0xff, 0xeb, 0xa2,
-	0x1e, 0xe8, 0x96, 0x00, 0xe8, 0x96, 0x00, 0xe8, 0x96, 0x00, 0xe8, 0x96, 0x00, 0x00, 0x00, 0xff,
-	0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0xe8, 0x96, 0x00, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00,
-	0xff, 0x00, 0x06, 0xff, 0x06, 0x08, 0xff, 0x08, 0x00, 0xf3, 0x00, 0x0b, 0xe6, 0x0b, 0x4e, 0xb5,
-	0x52, 0x00, 0x0d, 0xdf, 0x00, 0x05, 0xf0, 0x14, 0x14, 0xff, 0x23, 0x23, 0xff, 0x0b, 0x0b, 0xff,
-	0x59, 0x59, 0xff, 0x6a, 0x6a, 0xff, 0xe8, 0x96, 0x00, 0xe8, 0x96, 0x00, 0xe8, 0x96, 0x00, 0xe8,
-	0x96, 0x00, 0xe8, 0x96, 0x00, 0x00, 0x00, 0xff, 0x09, 0x09, 0xff, 0x48, 0x48, 0xff, 0xc9, 0x8a,
-	0x3a, 0xe8, 0x96, 0x00, 0xe8, 0x96, 0x00, 0xe8, 0x96, 0x00, 0xe8, 0x96, 0x00, 0x37, 0x38, 0xff,
-	0x27, 0x28, 0xff, 0xe3, 0x94, 0x0c, 0xe8, 0x96, 0x00, 0xe8, 0x96, 0x00, 0xe8, 0x96, 0x00, 0xe8,
-	0x96, 0x00, 0xe8, 0x96, 0x00, 0xe8, 0x96, 0x00, 0x00, 0x00, 0xff, 0xe8, 0x96, 0x00, 0xe8, 0x96,
-	0x00, 0xe6, 0x94, 0x02, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x66, 0xff, 0x66, 0x90, 0xff, 0x90,
-	0x00, 0xf7, 0x00, 0x04, 0xe2, 0x06, 0x1c, 0xa0, 0x1f, 0x00, 0x9d, 0x03, 0x5a, 0xeb, 0x5b, 0xe5,
-	0xe5, 0xff, 0xf5, 0xf5, 0xff, 0x49, 0x4a, 0xff, 0xf0, 0xf0, 0xff, 0x78, 0x78, 0xff, 0xe8, 0x96,
-	0x00, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0xe8, 0x96, 0x00, 0xe8, 0x96, 0x00, 0x00, 0x00, 0xff,
-	0x0b, 0x0b, 0xff, 0x2e, 0x2e, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0xe8,
-	0x96, 0x00, 0xe8, 0x96, 0x00, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00,
-	0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0xe8, 0x96, 0x00, 0xe8, 0x96, 0x00, 0xe8, 0x96, 0x00,
-	0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0xe8, 0x96, 0x00, 0x12, 0x0a, 0xeb, 0x00, 0xff, 0x00, 0x0b,
-	0xff, 0x0b, 0xbf, 0xff, 0xc0, 0x77, 0xff, 0x77, 0x00, 0xf9, 0x00, 0x00, 0xe3, 0x01, 0x00, 0xf4,
-	0x00, 0x00, 0xf5, 0x00, 0x14, 0x1a, 0xf2, 0x6e, 0x6e, 0xff, 0x30, 0x30, 0xff, 0x00, 0x00, 0xff,
-	0xcb, 0xcb, 0xff, 0xe8, 0x96, 0x00, 0xe8, 0x96, 0x00, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00,
-	0x00, 0xff, 0xe8, 0x96, 0x00, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x18, 0x19, 0xff, 0x0c, 0x0c,
-	0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0xe8, 0x96, 0x00, 0xe8, 0x96, 0x00,
-	0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00,
-	0x00, 0xff, 0xe8, 0x96, 0x00, 0xe8, 0x96, 0x00, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00,
-	0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x08, 0xff, 0x08, 0x5e, 0xff, 0x60, 0x00, 0xff, 0x00,
-	0x00, 0xfb, 0x00, 0x00, 0xe6, 0x01, 0x00, 0xee, 0x00, 0x00, 0x08, 0xeb, 0x00, 0x00, 0xff, 0x06,
-	0x06, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x02, 0x02, 0xff, 0xe8, 0x96, 0x00, 0xe8, 0x96,
-	0x00, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0xe8, 0x96, 0x00, 0xe8, 0x96, 0x00,
-	0x00, 0x00, 0xff, 0x4d, 0x4e, 0xff, 0x2b, 0x2c, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0xe8,
-	0x96, 0x00, 0xe8, 0x96, 0x00, 0xe8, 0x96, 0x00, 0x00, 0x00, 0xff, 0x2a, 0x2a, 0xff, 0x20, 0x20,
-	0xff, 0x00, 0x00, 0xff, 0xe8, 0x96, 0x00, 0xe8, 0x96, 0x00, 0xe8, 0x96, 0x00, 0x00, 0x00, 0xff,
-	0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0xe8, 0x96, 0x00, 0x07, 0x07, 0xff, 0x37, 0x37, 0xff, 0x00,
-	0x00, 0xff, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x0d, 0xfe, 0x0d, 0x5a, 0xc0, 0x5d, 0x00, 0x01,
-	0xfd, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0xcc, 0xcc, 0xff, 0xb2, 0xb2, 0xff, 0x40, 0x40, 0xff,
-	0x00, 0x00, 0xff, 0xe8, 0x96, 0x00, 0xe8, 0x96, 0x00, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00,
-	0x00, 0xff, 0xe8, 0x96, 0x00, 0xe8, 0x96, 0x00, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00,
-	0xff, 0xe8, 0x96, 0x00, 0xe8, 0x96, 0x00, 0xe5, 0x94, 0x03, 0xcf, 0x86, 0x1b, 0x00, 0x00, 0xff,
-	0x00, 0x00, 0xff, 0x1c, 0x1c, 0xff, 0x59, 0x59, 0xff, 0xe8, 0x96, 0x00, 0xe8, 0x96, 0x00, 0xe8,
-	0x96, 0x00, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0xe8, 0x96,
-	0x00, 0x17, 0x17, 0xff, 0xa7, 0xa7, 0xff, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00,
-	0x06, 0xff, 0x06, 0x19, 0x99, 0x1c, 0x00, 0xfe, 0x00, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x30,
-	0x30, 0xff, 0x13, 0x13, 0xff, 0x06, 0x06, 0xff, 0x00, 0x00, 0xff, 0xe8, 0x96, 0x00, 0xe8, 0x96,
-	0x00, 0x00, 0x00, 0xff, 0x1a, 0x1a, 0xff, 0x04, 0x04, 0xff, 0xe8, 0x96, 0x00, 0xe8, 0x96, 0x00,
-	0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0xe8, 0x96, 0x00, 0xe8, 0x96, 0x00, 0x00, 0x00, 0xff, 0x2b,
-	0x2b, 0xff, 0x2c, 0x2c, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0xe8, 0x96,
-	0x00, 0xe8, 0x96, 0x00, 0xe8, 0x96, 0x00, 0x00, 0x00, 0xff, 0xa1, 0xa1, 0xff, 0xec, 0xec, 0xff,
-	0x00, 0x00, 0xff, 0xe8, 0x96, 0x00, 0xe8, 0x96, 0x00, 0xe8, 0x96, 0x00, 0x00, 0x00, 0xff, 0x00,
-	0xff, 0x00, 0x1c, 0xff, 0x1c, 0xe8, 0xff, 0xe8, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0x00,
-	0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x16, 0x16, 0xff, 0x15, 0x15, 0xff, 0x00, 0x00, 0xff,
-	0x00, 0x00, 0xff, 0xe8, 0x96, 0x00, 0xe8, 0x96, 0x00, 0x00, 0x00, 0xff, 0xcc, 0xcc, 0xff, 0xc2,
-	0xc2, 0xff, 0xe8, 0x96, 0x00, 0xe8, 0x96, 0x00, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0xe8, 0x96,
-	0x00, 0xe8, 0x96, 0x00, 0x00, 0x00, 0xff, 0x2c, 0x2c, 0xff, 0xbd, 0xbd, 0xff, 0x00, 0x00, 0xff,
-	0x00, 0x00, 0xff, 0x21, 0x21, 0xff, 0xec, 0xa9, 0x30, 0xe8, 0x96, 0x00, 0xe8, 0x96, 0x00, 0x00,
-	0x00, 0xff, 0xd5, 0xd5, 0xff, 0x6e, 0x6e, 0xff, 0x00, 0x00, 0xff, 0xe8, 0x96, 0x00, 0xe8, 0x96,
-	0x00, 0xe5, 0x94, 0x03, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x15, 0xff, 0x1d, 0xc5, 0xff, 0xce,
-	0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x1b, 0x1b, 0xff, 0x03, 0x03, 0xff, 0x00, 0x00, 0xff, 0x00,
-	0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x29, 0x29, 0xff, 0xe8, 0x97, 0x03, 0xe8, 0x96,
-	0x00, 0x00, 0x00, 0xff, 0x01, 0x01, 0xff, 0xe8, 0x98, 0x05, 0xe8, 0x96, 0x00, 0x00, 0x00, 0xff,
-	0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0xe8, 0x96, 0x00, 0xe8, 0x96, 0x00, 0xe8, 0x96, 0x00, 0xe8,
-	0x98, 0x05, 0xea, 0xa0, 0x19, 0xe8, 0x96, 0x00, 0x00, 0x00, 0xff, 0x8e, 0x90, 0xff, 0xf6, 0xe3,
-	0xbb, 0xe8, 0x96, 0x00, 0xe8, 0x96, 0x00, 0xe8, 0x96, 0x00, 0xea, 0x9f, 0x16, 0xe9, 0x99, 0x07,
-	0x00, 0x00, 0xff, 0xe8, 0x96, 0x00, 0xe8, 0x96, 0x00, 0xcc, 0x84, 0x1f, 0x13, 0x13, 0xff, 0x02,
-	0x02, 0xff, 0x00, 0xff, 0xfc, 0x00, 0xff, 0xef, 0x00, 0xff, 0x9f, 0x74, 0x74, 0xff, 0xf5, 0xf5,
-	0xff, 0x47, 0x47, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff,
-	0x33, 0x33, 0xff, 0xe9, 0x9c, 0x0e, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x0c, 0x0c, 0xff, 0xc2,
-	0xc2, 0xff, 0x19, 0x19, 0xff, 0x19, 0x19, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00,
-	0xff, 0xe8, 0x96, 0x00, 0xe8, 0x96, 0x00, 0xea, 0xa1, 0x1b, 0xe8, 0x97, 0x02, 0x00, 0x00, 0xff,
-	0x00, 0x00, 0xff, 0x2a, 0x2a, 0xff, 0xac, 0xac, 0xff, 0xea, 0x9d, 0x11, 0xe8, 0x96, 0x00, 0xe8,
-	0x96, 0x00, 0x66, 0x66, 0xff, 0x1c, 0x1c, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0xe8, 0x96,
-	0x00, 0x00, 0x00, 0xff, 0x23, 0x23, 0xff, 0x04, 0x04, 0xff, 0x00, 0xff, 0xff, 0x00, 0xff, 0xff,
-	0x15, 0xf6, 0xff, 0xea, 0xea, 0xff, 0x36, 0x36, 0xff, 0x03, 0x03, 0xff, 0x00, 0x00, 0xff, 0x0b,
-	0x0b, 0xff, 0x32, 0x33, 0xff, 0x00, 0x00, 0xff, 0x15, 0x15, 0xff, 0x0a, 0x0a, 0xff, 0x00, 0x00,
-	0xff, 0x00, 0x00, 0xff, 0x02, 0x02, 0xff, 0x2c, 0x2c, 0xff, 0x04, 0x04, 0xff, 0x00, 0x00, 0xff,
-	0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x99,
-	0x99, 0xff, 0x41, 0x41, 0xff, 0x0b, 0x0b, 0xff, 0x00, 0x00, 0xff, 0x0c, 0x0c, 0xff, 0xa5, 0xa5,
-	0xff, 0xb2, 0xb2, 0xff, 0x00, 0x00, 0xff, 0x28, 0x28, 0xff, 0x28, 0x28, 0xff, 0x25, 0x25, 0xff,
-	0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x1a, 0x1b, 0xff, 0x0e,
-	0x0e, 0xff, 0x1e, 0x93, 0xff, 0x03, 0xe5, 0xff, 0x0f, 0x20, 0xff, 0x22, 0x22, 0xff, 0x16, 0x17,
-	0xff, 0x0f, 0x0f, 0xff, 0x00, 0x00, 0xff, 0x06, 0x06, 0xff, 0x06, 0x06, 0xff, 0x00, 0x00, 0xff,
-	0x02, 0x02, 0xff, 0x0a, 0x0b, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x13, 0x13, 0xff, 0x27,
-	0x27, 0xff, 0x00, 0x00, 0xff, 0x02, 0x02, 0xff, 0x2b, 0x2b, 0xff, 0x08, 0x08, 0xff, 0x07, 0x07,
-	0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x08, 0x08, 0xff, 0x00, 0x00, 0xff,
-	0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x0d, 0x0d, 0xff, 0x4e, 0x4e, 0xff, 0x00, 0x00, 0xff, 0x05,
-	0x05, 0xff, 0x0b, 0x0b, 0xff, 0x05, 0x05, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00,
-	0xff, 0x00, 0x00, 0xff, 0x12, 0x13, 0xff, 0x12, 0x12, 0xff, 0x00, 0x00, 0xff, 0x06, 0x06, 0xff,
-	0x13, 0x14, 0xff, 0x0f, 0x0f, 0xff, 0x12, 0x12, 0xff, 0x08, 0x08, 0xff, 0x00, 0x00, 0xff, 0x00,
-	0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x26, 0x27, 0xff, 0x17, 0x17, 0xff, 0x00, 0x00,
-	0xff, 0x00, 0x00, 0xff, 0x2b, 0x2b, 0xff, 0x09, 0x09, 0xff, 0x79, 0x79, 0xff, 0x0c, 0x0c, 0xff,
-	0xc7, 0xc7, 0xff, 0xf4, 0xf4, 0xff, 0xec, 0xec, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x14,
-	0x14, 0xff, 0x15, 0x15, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x20, 0x20, 0xff, 0x28, 0x28,
-	0xff, 0x28, 0x28, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x03, 0x03, 0xff, 0x16, 0x17, 0xff,
-	0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00,
-	0x00, 0xff, 0x00, 0x00, 0xff, 0x0b, 0x0b, 0xff, 0x2b, 0x2b, 0xff, 0x1a, 0x1a, 0xff, 0x07, 0x07,
-	0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff,
-	0x00, 0x00
+
+// 'g' and one of these
+const cmdEntry cmdsGet[] PROGMEM = {
+  { 'A', CMDARG_NONE, 0,             NULL,       replyAddr },
+  { 'B', CMDARG_NONE, 0,             NULL,       replyString },
+  { 'L', CMDARG_NONE, 0,             NULL,       replyLevel },
+  { 'D', CMDARG_NONE, 0,             NULL,       replyDither },
+  { 'P', CMDARG_NONE, 0,             NULL,       replyPower },
+  { 'E', CMDARG_NONE, 0,             NULL,       replyErrors },
+  { 'F', CMDARG_NONE, 0,             NULL,       replyFrames },
+  { 'I', CMDARG_NONE, 0,             NULL,       replyOutput },
+  { 'T', CMDARG_NUM,  PROF_SLOTS-1,  errBadSlot, replyProfile },
 };
-// End of Block 3
-
-const u08 block4[] PROGMEM = {
-	0xe4, 0xe7, 0xff, 0xe3, 0xe7, 0xff, 0xe0, 0xe4, 0xff, 0xe1, 0xe5, 0xff, 0xe2, 0xe6, 0xff, 0xe4,
-	0xe7, 0xff, 0xe6, 0xea, 0xff, 0xe7, 0xeb, 0xff, 0xe3, 0xe7, 0xff, 0xdf, 0xe2, 0xff, 0xe1, 0xe5,
-	0xff, 0xe1, 0xe4, 0xff, 0xd6, 0xda, 0xff, 0xcd, 0xd0, 0xff, 0xc7, 0xca, 0xff, 0xc4, 0xc7, 0xff,
-	0xe0, 0xe4, 0xff, 0xdf, 0xe2, 0xff, 0xd7, 0xdb, 0xff, 0xde, 0xe2, 0xff, 0xdc, 0xdf, 0xff, 0xc7,
-	0xc9, 0xff, 0xc0, 0xc3, 0xff, 0xc1, 0xc4, 0xff, 0xc8, 0xcb, 0xff, 0xd2, 0xd6, 0xff, 0xe8, 0xeb,
-	0xff, 0xf5, 0xf9, 0xff, 0xfa, 0xfe, 0xff, 0xfb, 0xfe, 0xff, 0xf8, 0xfc, 0xff, 0xe8, 0xec, 0xff,
-	0xdf, 0xe2, 0xff, 0xf9, 0xfd, 0xff, 0xf7, 0xfb, 0xff, 0xf7, 0xfb, 0xff, 0xf6, 0xfa, 0xff, 0xf2,
-	0xf6, 0xff, 0xf3, 0xf7, 0xff, 0xe3, 0xe7, 0xff, 0xf0, 0xf4, 0xff, 0xd5, 0xd9, 0xff, 0xe8, 0xeb,
-	0xff, 0xef, 0xf3, 0xff, 0xf2, 0xf4, 0xff, 0xf3, 0xf7, 0xff, 0xf0, 0xf3, 0xff, 0xed, 0xf1, 0xff,
-	0xec, 0xf0, 0xff, 0xe6, 0xea, 0xff, 0xb9, 0xbc, 0xff, 0xbb, 0xbe, 0xff, 0xbd, 0xc0, 0xff, 0xaa,
-	0xac, 0xff, 0xb8, 0xba, 0xff, 0xc6, 0xc9, 0xff, 0xda, 0xdd, 0xff, 0xdb, 0xdf, 0xff, 0xd8, 0xdc,
-	0xff, 0xe6, 0xea, 0xff, 0xe0, 0xe4, 0xff, 0xdc, 0xdf, 0xff, 0xd0, 0xd3, 0xff, 0xb5, 0xb9, 0xff,
-	0xa9, 0xac, 0xff, 0xe5, 0xe8, 0xff, 0xd4, 0xd8, 0xff, 0xb4, 0xb7, 0xff, 0xd3, 0xd6, 0xff, 0x9e,
-	0xa0, 0xff, 0x8d, 0x8e, 0xff, 0x92, 0x94, 0xff, 0xa4, 0xa7, 0xff, 0xd4, 0xd5, 0xff, 0xd0, 0xd1,
-	0xff, 0xaa, 0xab, 0xff, 0xbd, 0xc0, 0xff, 0xec, 0xee, 0xff, 0xf8, 0xf9, 0xff, 0xcc, 0xce, 0xff,
-	0xed, 0xf1, 0xff, 0xed, 0xf1, 0xff, 0xcb, 0xcc, 0xff, 0xc1, 0xc1, 0xff, 0xab, 0xac, 0xff, 0x92,
-	0x92, 0xff, 0x99, 0x9a, 0xff, 0xb7, 0xb8, 0xff, 0xb0, 0xb2, 0xff, 0xd9, 0xdb, 0xff, 0xfb, 0xfe,
-	0xff, 0xf9, 0xfc, 0xff, 0xf3, 0xf6, 0xff, 0xf7, 0xfb, 0xff, 0xf7, 0xfb, 0xff, 0xfa, 0xfe, 0xff,
-	0xfb, 0xff, 0xff, 0xf5, 0xf9, 0xff, 0xe2, 0xe6, 0xff, 0xdb, 0xde, 0xff, 0xe3, 0xe6, 0xff, 0xeb,
-	0xef, 0xff, 0xe9, 0xed, 0xff, 0xe8, 0xec, 0xff, 0xf9, 0xfb, 0xff, 0xf6, 0xf7, 0xff, 0xed, 0xed,
-	0xff, 0xdf, 0xe0, 0xff, 0xbf, 0xc2, 0xff, 0xb2, 0xb4, 0xff, 0x8e, 0x8e, 0xff, 0xcc, 0xd6, 0xe2,
-	0x11, 0x43, 0x78, 0x11, 0x43, 0x78, 0x59, 0x59, 0xff, 0x1d, 0x1d, 0xff, 0x44, 0x44, 0xff, 0xb2,
-	0xb2, 0xff, 0xe2, 0xe2, 0xff, 0xea, 0xea, 0xff, 0x00, 0x00, 0xff, 0x43, 0x44, 0xff, 0xc3, 0xc6,
-	0xff, 0xb9, 0xbb, 0xff, 0x28, 0x29, 0xff, 0x56, 0x58, 0xff, 0xb4, 0xb7, 0xff, 0xbd, 0xbe, 0xff,
-	0xc2, 0xc2, 0xff, 0xc4, 0xc4, 0xff, 0x72, 0x72, 0xff, 0xe7, 0xe7, 0xff, 0x5b, 0x5c, 0xff, 0x01,
-	0x01, 0xff, 0x4c, 0x4d, 0xff, 0x46, 0x46, 0xff, 0x73, 0x73, 0xff, 0x9e, 0xa0, 0xff, 0x33, 0x34,
-	0xff, 0x3d, 0x3e, 0xff, 0xca, 0xca, 0xff, 0xd6, 0xd6, 0xff, 0x43, 0x43, 0xff, 0x32, 0x33, 0xff,
-	0xde, 0xe1, 0xff, 0xa4, 0xa4, 0xff, 0xba, 0xba, 0xff, 0x91, 0x92, 0xff, 0x0e, 0x0e, 0xff, 0x4f,
-	0x4f, 0xff, 0x66, 0x66, 0xff, 0x11, 0x43, 0x78, 0x11, 0x43, 0x78, 0x11, 0x43, 0x78, 0x00, 0x00,
-	0xff, 0x00, 0x00, 0xff, 0x8e, 0x8e, 0xff, 0x4c, 0x4d, 0xff, 0xf5, 0xf9, 0xff, 0xfa, 0xfa, 0xff,
-	0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x0f, 0x0f, 0xff, 0x68, 0x68, 0xff, 0x45, 0x45, 0xff, 0x14,
-	0x14, 0xff, 0x00, 0x00, 0xff, 0x0d, 0x0d, 0xff, 0x85, 0x85, 0xff, 0x21, 0x21, 0xff, 0x25, 0x25,
-	0xff, 0x83, 0x83, 0xff, 0x05, 0x05, 0xff, 0x00, 0x00, 0xff, 0x31, 0x31, 0xff, 0x5e, 0x5e, 0xff,
-	0xd5, 0xd6, 0xff, 0xd1, 0xd1, 0xff, 0x37, 0x37, 0xff, 0x00, 0x00, 0xff, 0x4a, 0x4b, 0xff, 0xf4,
-	0xf8, 0xff, 0x01, 0x01, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x0d, 0x0d, 0xff, 0x9f, 0x9f,
-	0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x1f, 0x1f, 0xff, 0x28, 0x28, 0xff, 0x11, 0x43, 0x78,
-	0x11, 0x43, 0x78, 0x11, 0x43, 0x78, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0xa7,
-	0xa7, 0xff, 0x5f, 0x61, 0xff, 0xc1, 0xc1, 0xff, 0x5f, 0x5f, 0xff, 0x01, 0x01, 0xff, 0x00, 0x00,
-	0xff, 0x07, 0x07, 0xff, 0x37, 0x37, 0xff, 0x00, 0x00, 0xff, 0x11, 0x11, 0xff, 0x18, 0x18, 0xff,
-	0x00, 0x00, 0xff, 0x18, 0x18, 0xff, 0x50, 0x50, 0xff, 0x96, 0x96, 0xff, 0x21, 0x22, 0xff, 0x00,
-	0x00, 0xff, 0x1d, 0x1d, 0xff, 0x50, 0x51, 0xff, 0x8f, 0x91, 0xff, 0xd2, 0xd2, 0xff, 0xec, 0xec,
-	0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff,
-	0x00, 0x00, 0xff, 0x42, 0x42, 0xff, 0x4c, 0x4c, 0xff, 0x00, 0xec, 0x01, 0x00, 0xef, 0x01, 0x00,
-	0xef, 0x00, 0x00, 0xfe, 0x00, 0x00, 0xbd, 0x02, 0x0c, 0x4e, 0x54, 0x11, 0x43, 0x78, 0x00, 0x00,
-	0xff, 0x00, 0x00, 0xff, 0x0c, 0x0c, 0xff, 0x7f, 0x7f, 0xff, 0x87, 0x87, 0xff, 0x00, 0x00, 0xff,
-	0xd0, 0xd0, 0xff, 0x08, 0x08, 0xff, 0x00, 0x00, 0xff, 0x27, 0x28, 0xff, 0x31, 0x32, 0xff, 0x00,
-	0x00, 0xff, 0x04, 0x04, 0xff, 0x1e, 0x1e, 0xff, 0x00, 0x00, 0xff, 0x36, 0x36, 0xff, 0x12, 0x12,
-	0xff, 0x13, 0x13, 0xff, 0x03, 0x03, 0xff, 0x06, 0x06, 0xff, 0x02, 0x02, 0xff, 0x02, 0x02, 0xff,
-	0x0a, 0x0a, 0xff, 0x1e, 0x1e, 0xff, 0x19, 0x19, 0xff, 0x12, 0x13, 0xff, 0x00, 0x00, 0xff, 0x26,
-	0x26, 0xff, 0xa7, 0xa7, 0xff, 0x83, 0x83, 0xff, 0x00, 0x00, 0xff, 0x23, 0x23, 0xff, 0x03, 0x03,
-	0xff, 0x00, 0x00, 0xfe, 0x00, 0xf8, 0x00, 0x00, 0xe2, 0x01, 0x00, 0xd5, 0x02, 0x00, 0xd4, 0x01,
-	0x00, 0xdd, 0x01, 0x00, 0xb6, 0x02, 0x00, 0x96, 0x03, 0x00, 0xa7, 0x29, 0x2d, 0x2d, 0xfe, 0x7d,
-	0x7e, 0xfc, 0x00, 0x00, 0xff, 0x01, 0x01, 0xff, 0xd5, 0xd5, 0xff, 0xb1, 0xb1, 0xff, 0x00, 0x00,
-	0xff, 0x0a, 0x0a, 0xff, 0x1f, 0x1f, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff,
-	0x07, 0x07, 0xff, 0x28, 0x29, 0xff, 0x00, 0x00, 0xff, 0x20, 0x21, 0xff, 0x2c, 0x2d, 0xff, 0x10,
-	0x11, 0xff, 0x12, 0x12, 0xff, 0x3f, 0x41, 0xff, 0x04, 0x04, 0xff, 0x1e, 0x1f, 0xff, 0x47, 0x47,
-	0xff, 0x35, 0x36, 0xff, 0x00, 0x00, 0xff, 0x33, 0x33, 0xff, 0xd2, 0xd2, 0xff, 0x5d, 0x5d, 0xff,
-	0x00, 0x00, 0xff, 0x07, 0x07, 0xff, 0x06, 0x06, 0xff, 0x00, 0x00, 0xff, 0x00, 0xff, 0x00, 0x23,
-	0xff, 0x24, 0x6b, 0xfc, 0x6d, 0x00, 0xea, 0x00, 0x00, 0xd4, 0x01, 0x00, 0x9f, 0x03, 0x4e, 0xb9,
-	0x4f, 0x28, 0xc9, 0x2a, 0x00, 0xc3, 0x02, 0x00, 0xb3, 0x02, 0x09, 0x09, 0xff, 0x01, 0x01, 0xff,
-	0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00,
-	0x00, 0xff, 0x14, 0x14, 0xff, 0x12, 0x12, 0xff, 0x0b, 0x0b, 0xff, 0x17, 0x17, 0xff, 0x00, 0x00,
-	0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x03, 0x03, 0xff, 0x15, 0x16, 0xff,
-	0x26, 0x26, 0xff, 0x8b, 0x8b, 0xff, 0xb3, 0xb3, 0xff, 0x4c, 0x4c, 0xff, 0x00, 0x00, 0xff, 0x00,
-	0x00, 0xff, 0x72, 0x72, 0xff, 0x3b, 0x3b, 0xff, 0x00, 0x00, 0xff, 0x2b, 0x2b, 0xff, 0x32, 0x32,
-	0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x1a, 0xff, 0x1a, 0x4e, 0xff, 0x4f, 0x00, 0xff, 0x00,
-	0x00, 0xde, 0x01, 0x00, 0xe2, 0x00, 0x58, 0xe4, 0x59, 0x2e, 0xc2, 0x2f, 0x00, 0xc9, 0x01, 0x2d,
-	0x38, 0xe6, 0x13, 0x13, 0xff, 0x03, 0x03, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0xe8, 0x96,
-	0x00, 0xe8, 0x96, 0x00, 0xe8, 0x96, 0x00, 0xe8, 0x96, 0x00, 0x1e, 0x1f, 0xff, 0x0c, 0x0c, 0xff,
-	0x00, 0x00, 0xff, 0x0e, 0x0e, 0xff, 0x15, 0x15, 0xff, 0xe8, 0x96, 0x00, 0xe8, 0x96, 0x00, 0x00,
-	0x00, 0xff, 0x0a, 0x0a, 0xff, 0x35, 0x36, 0xff, 0x3c, 0x3d, 0xff, 0xfb, 0xfb, 0xff, 0xeb, 0xa2,
-	0x1e, 0xe8, 0x96, 0x00, 0xe8, 0x96, 0x00, 0xe8, 0x96, 0x00, 0xe8, 0x96, 0x00, 0x00, 0x00, 0xff,
-	0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0xe8, 0x96, 0x00, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00,
-	0xff, 0x00, 0x06, 0xff, 0x06, 0x08, 0xff, 0x08, 0x00, 0xf3, 0x00, 0x0b, 0xe6, 0x0b, 0x4e, 0xb5,
-	0x52, 0x00, 0x0d, 0xdf, 0x00, 0x05, 0xf0, 0xab, 0xab, 0xff, 0x65, 0x65, 0xff, 0x0b, 0x0b, 0xff,
-	0x59, 0x59, 0xff, 0x6a, 0x6a, 0xff, 0xe8, 0x96, 0x00, 0xe8, 0x96, 0x00, 0xe8, 0x96, 0x00, 0xe8,
-	0x96, 0x00, 0xe8, 0x96, 0x00, 0x00, 0x00, 0xff, 0x09, 0x09, 0xff, 0x48, 0x48, 0xff, 0xc9, 0x8a,
-	0x3a, 0xe8, 0x96, 0x00, 0xe8, 0x96, 0x00, 0xe8, 0x96, 0x00, 0xe8, 0x96, 0x00, 0x37, 0x38, 0xff,
-	0x27, 0x28, 0xff, 0xe3, 0x94, 0x0c, 0xe8, 0x96, 0x00, 0xe8, 0x96, 0x00, 0xe8, 0x96, 0x00, 0xe8,
-	0x96, 0x00, 0xe8, 0x96, 0x00, 0xe8, 0x96, 0x00, 0x00, 0x00, 0xff, 0xe8, 0x96, 0x00, 0xe8, 0x96,
-	0x00, 0xe8, 0x96, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x66, 0xff, 0x66, 0x90, 0xff, 0x90,
-	0x00, 0xf7, 0x00, 0x04, 0xe2, 0x06, 0x1c, 0xa0, 0x1f, 0x00, 0x9d, 0x03, 0x5a, 0xeb, 0x5b, 0xe8,
-	0xe8, 0xff, 0xfc, 0xfc, 0xff, 0x49, 0x4a, 0xff, 0xf0, 0xf0, 0xff, 0x78, 0x78, 0xff, 0xe8, 0x96,
-	0x00, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0xe8, 0x96, 0x00, 0xe8, 0x96, 0x00, 0x00, 0x00, 0xff,
-	0x0b, 0x0b, 0xff, 0x2e, 0x2e, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0xe8,
-	0x96, 0x00, 0xe8, 0x96, 0x00, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00,
-	0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0xe8, 0x96, 0x00, 0xe8, 0x96, 0x00, 0xe8, 0x96, 0x00,
-	0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0xe8, 0x96, 0x00, 0x00, 0x00, 0xff, 0x00, 0xff, 0x00, 0x0b,
-	0xff, 0x0b, 0xbf, 0xff, 0xc0, 0x77, 0xff, 0x77, 0x00, 0xf9, 0x00, 0x00, 0xe3, 0x01, 0x00, 0xf4,
-	0x00, 0x00, 0xf5, 0x00, 0x14, 0x1a, 0xf2, 0x21, 0x21, 0xff, 0x25, 0x25, 0xff, 0x00, 0x00, 0xff,
-	0xcb, 0xcb, 0xff, 0xe8, 0x96, 0x00, 0xe8, 0x96, 0x00, 0x00, 0x00, 0xff, 0x37, 0x37, 0xff, 0x61,
-	0x61, 0xff, 0xe8, 0x96, 0x00, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x18, 0x19, 0xff, 0x0c, 0x0c,
-	0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0xe8, 0x96, 0x00, 0xe8, 0x96, 0x00,
-	0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00,
-	0x00, 0xff, 0xe8, 0x96, 0x00, 0xe8, 0x96, 0x00, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00,
-	0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x08, 0xff, 0x08, 0x5e, 0xff, 0x60, 0x00, 0xff, 0x00,
-	0x00, 0xfb, 0x00, 0x00, 0xe6, 0x01, 0x00, 0xee, 0x00, 0x00, 0x08, 0xeb, 0x00, 0x00, 0xff, 0x06,
-	0x06, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x02, 0x02, 0xff, 0xe8, 0x96, 0x00, 0xe8, 0x96,
-	0x00, 0x00, 0x00, 0xff, 0xbe, 0xbe, 0xff, 0xc0, 0xc0, 0xff, 0xe8, 0x96, 0x00, 0xe8, 0x96, 0x00,
-	0x00, 0x00, 0xff, 0x4d, 0x4e, 0xff, 0x2b, 0x2c, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0xe8,
-	0x96, 0x00, 0xe8, 0x96, 0x00, 0xe8, 0x96, 0x00, 0x00, 0x00, 0xff, 0x2a, 0x2a, 0xff, 0x20, 0x20,
-	0xff, 0x00, 0x00, 0xff, 0xe8, 0x96, 0x00, 0xe8, 0x96, 0x00, 0xe8, 0x96, 0x00, 0x00, 0x00, 0xff,
-	0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0xe8, 0x96, 0x00, 0x07, 0x07, 0xff, 0x37, 0x37, 0xff, 0x00,
-	0x00, 0xff, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x0d, 0xfe, 0x0d, 0x5a, 0xc0, 0x5d, 0x00, 0x01,
-	0xfd, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x2c, 0x2c, 0xff, 0x13, 0x13, 0xff, 0x33, 0x33, 0xff,
-	0x00, 0x00, 0xff, 0xe8, 0x96, 0x00, 0xe8, 0x96, 0x00, 0x00, 0x00, 0xff, 0x28, 0x28, 0xff, 0x0f,
-	0x0f, 0xff, 0xe8, 0x96, 0x00, 0xe8, 0x96, 0x00, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00,
-	0xff, 0xe8, 0x96, 0x00, 0xe8, 0x96, 0x00, 0xe5, 0x94, 0x03, 0xcf, 0x86, 0x1b, 0x00, 0x00, 0xff,
-	0x00, 0x00, 0xff, 0x1c, 0x1c, 0xff, 0x59, 0x59, 0xff, 0xe8, 0x96, 0x00, 0xe8, 0x96, 0x00, 0xe8,
-	0x96, 0x00, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0xe8, 0x96,
-	0x00, 0x17, 0x17, 0xff, 0xa7, 0xa7, 0xff, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00,
-	0x06, 0xff, 0x06, 0x19, 0x99, 0x1c, 0x00, 0xfe, 0x00, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x30,
-	0x30, 0xff, 0x13, 0x13, 0xff, 0x06, 0x06, 0xff, 0x00, 0x00, 0xff, 0xe8, 0x96, 0x00, 0xe8, 0x96,
-	0x00, 0x00, 0x00, 0xff, 0x1a, 0x1a, 0xff, 0x04, 0x04, 0xff, 0xe8, 0x96, 0x00, 0xe8, 0x96, 0x00,
-	0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0xe8, 0x96, 0x00, 0xe8, 0x96, 0x00, 0x00, 0x00, 0xff, 0x2b,
-	0x2b, 0xff, 0x2c, 0x2c, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0xe8, 0x96,
-	0x00, 0xe8, 0x96, 0x00, 0xe8, 0x96, 0x00, 0x00, 0x00, 0xff, 0x75, 0x75, 0xff, 0x30, 0x30, 0xff,
-	0x00, 0x00, 0xff, 0xe8, 0x96, 0x00, 0xe8, 0x96, 0x00, 0xe8, 0x96, 0x00, 0x00, 0x00, 0xff, 0x00,
-	0xff, 0x00, 0x1c, 0xff, 0x1c, 0xe8, 0xff, 0xe8, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0x00,
-	0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x16, 0x16, 0xff, 0x15, 0x15, 0xff, 0x00, 0x00, 0xff,
-	0x00, 0x00, 0xff, 0xe8, 0x96, 0x00, 0xe8, 0x96, 0x00, 0x00, 0x00, 0xff, 0xcc, 0xcc, 0xff, 0xc2,
-	0xc2, 0xff, 0xe8, 0x96, 0x00, 0xe8, 0x96, 0x00, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0xe8, 0x96,
-	0x00, 0xe8, 0x96, 0x00, 0x00, 0x00, 0xff, 0x2c, 0x2c, 0xff, 0xbd, 0xbd, 0xff, 0x00, 0x00, 0xff,
-	0x00, 0x00, 0xff, 0x21, 0x21, 0xff, 0xec, 0xa9, 0x30, 0xe8, 0x96, 0x00, 0xe8, 0x96, 0x00, 0x00,
-	0x00, 0xff, 0x49, 0x49, 0xff, 0x59, 0x59, 0xff, 0x00, 0x00, 0xff, 0xe8, 0x96, 0x00, 0xe8, 0x96,
-	0x00, 0xe5, 0x94, 0x03, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x16, 0xff, 0x16, 0xca, 0xff, 0xcc,
-	0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x1b, 0x1b, 0xff, 0x03, 0x03, 0xff, 0x00, 0x00, 0xff, 0x00,
-	0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x29, 0x29, 0xff, 0xe8, 0x97, 0x03, 0xe8, 0x96,
-	0x00, 0x00, 0x00, 0xff, 0x01, 0x01, 0xff, 0xe8, 0x98, 0x05, 0xe8, 0x96, 0x00, 0x00, 0x00, 0xff,
-	0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0xe8, 0x96, 0x00, 0xe8, 0x96, 0x00, 0xe8, 0x96, 0x00, 0xe8,
-	0x98, 0x05, 0xea, 0xa0, 0x19, 0xe8, 0x96, 0x00, 0x00, 0x00, 0xff, 0x05, 0x05, 0xff, 0x54, 0x51,
-	0xf4, 0xe8, 0x96, 0x00, 0xe8, 0x96, 0x00, 0xe8, 0x96, 0x00, 0xea, 0x9f, 0x16, 0xe9, 0x99, 0x07,
-	0x00, 0x00, 0xff, 0xe8, 0x96, 0x00, 0xe8, 0x96, 0x00, 0xcc, 0x84, 0x1f, 0x13, 0x13, 0xff, 0x02,
-	0x02, 0xff, 0x00, 0xff, 0xef, 0x00, 0xff, 0xff, 0x00, 0xff, 0x9f, 0x4a, 0x4a, 0xff, 0x0e, 0x0e,
-	0xff, 0x43, 0x43, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff,
-	0x33, 0x33, 0xff, 0xe9, 0x9c, 0x0e, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x0c, 0x0c, 0xff, 0xc2,
-	0xc2, 0xff, 0x19, 0x19, 0xff, 0x19, 0x19, 0xff, 0x0e, 0x0e, 0xff, 0xd4, 0xd4, 0xff, 0x67, 0x67,
-	0xff, 0xe8, 0x96, 0x00, 0xe8, 0x96, 0x00, 0xea, 0xa1, 0x1b, 0xe8, 0x97, 0x02, 0x00, 0x00, 0xff,
-	0x00, 0x00, 0xff, 0x24, 0x24, 0xff, 0x36, 0x36, 0xff, 0xcf, 0x8b, 0x2c, 0xe8, 0x96, 0x00, 0xe8,
-	0x96, 0x00, 0x66, 0x66, 0xff, 0x1c, 0x1c, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0xe8, 0x96,
-	0x00, 0x00, 0x00, 0xff, 0x23, 0x23, 0xff, 0x04, 0x04, 0xff, 0x00, 0xf8, 0xff, 0x00, 0xff, 0xff,
-	0x1b, 0xd2, 0xff, 0x56, 0x56, 0xff, 0x2f, 0x2f, 0xff, 0x03, 0x03, 0xff, 0x00, 0x00, 0xff, 0x0b,
-	0x0b, 0xff, 0x32, 0x33, 0xff, 0x00, 0x00, 0xff, 0x15, 0x15, 0xff, 0x0a, 0x0a, 0xff, 0x00, 0x00,
-	0xff, 0x00, 0x00, 0xff, 0x02, 0x02, 0xff, 0x2c, 0x2c, 0xff, 0x04, 0x04, 0xff, 0x00, 0x00, 0xff,
-	0x88, 0x88, 0xff, 0xed, 0xed, 0xff, 0x72, 0x72, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x4a,
-	0x4a, 0xff, 0x41, 0x41, 0xff, 0x0b, 0x0b, 0xff, 0x00, 0x00, 0xff, 0x0c, 0x0c, 0xff, 0x1d, 0x1d,
-	0xff, 0x41, 0x41, 0xff, 0x00, 0x00, 0xff, 0x28, 0x28, 0xff, 0x28, 0x28, 0xff, 0x25, 0x25, 0xff,
-	0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x1a, 0x1b, 0xff, 0x0e,
-	0x0e, 0xff, 0x33, 0x46, 0xff, 0x01, 0xf7, 0xff, 0x0e, 0x23, 0xff, 0x20, 0x20, 0xff, 0x16, 0x17,
-	0xff, 0x0f, 0x0f, 0xff, 0x00, 0x00, 0xff, 0x06, 0x06, 0xff, 0x06, 0x06, 0xff, 0x00, 0x00, 0xff,
-	0x02, 0x02, 0xff, 0x0a, 0x0b, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x13, 0x13, 0xff, 0x27,
-	0x27, 0xff, 0x00, 0x00, 0xff, 0x01, 0x01, 0xff, 0x19, 0x19, 0xff, 0x05, 0x05, 0xff, 0x05, 0x05,
-	0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x08, 0x08, 0xff, 0x00, 0x00, 0xff,
-	0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x09, 0x09, 0xff, 0x3e, 0x3e, 0xff, 0x00, 0x00, 0xff, 0x10,
-	0x10, 0xff, 0x45, 0x45, 0xff, 0x41, 0x41, 0xff, 0x3e, 0x3e, 0xff, 0x3a, 0x3a, 0xff, 0x00, 0x00,
-	0xff, 0x00, 0x00, 0xff, 0x12, 0x13, 0xff, 0x12, 0x12, 0xff, 0x01, 0x01, 0xff, 0x9c, 0x9c, 0xff,
-	0x4a, 0x4a, 0xff, 0x0f, 0x0f, 0xff, 0x12, 0x12, 0xff, 0x08, 0x08, 0xff, 0x1a, 0x1a, 0xff, 0x09,
-	0x09, 0xff, 0x1d, 0x1d, 0xff, 0x00, 0x00, 0xff, 0x26, 0x27, 0xff, 0x17, 0x17, 0xff, 0x00, 0x00,
-	0xff, 0x00, 0x00, 0xff, 0x2b, 0x2b, 0xff, 0x09, 0x09, 0xff, 0x3e, 0x3e, 0xff, 0x03, 0x03, 0xff,
-	0x1d, 0x1d, 0xff, 0x1d, 0x1d, 0xff, 0x1a, 0x1a, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x0e,
-	0x0e, 0xff, 0x15, 0x15, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x20, 0x20, 0xff, 0x28, 0x28,
-	0xff, 0x28, 0x28, 0xff, 0x00, 0x00, 0xff, 0x21, 0x21, 0xff, 0xaa, 0xaa, 0xff, 0xb0, 0xb1, 0xff,
-	0xa8, 0xa8, 0xff, 0x94, 0x94, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00, 0x00, 0xff, 0x00,
-	0x00, 0xff, 0x25, 0x25, 0xff, 0xd7, 0xd7, 0xff, 0x34, 0x34, 0xff, 0x1a, 0x1a, 0xff, 0x07, 0x07,
-	0xff, 0x00, 0x00, 0xff, 0xbc, 0xbc, 0xff, 0xd5, 0xd5, 0xff, 0xc2, 0xc2, 0xff, 0x00, 0x00, 0xff,
-	0x00, 0x00
+
+cmdTable cmdTableMain;
+cmdTable cmdTableGet;
+
+/*************************************************/
+/*************************************************/
+/* USS Christmas tree scene, snowing.            */
+// Made from images/ussxmas1-4.bmp by tools/imgconv,
+// run "make images" there after changing a BMP.
+/*************************************************/
+/*************************************************/
+#include "../images/ussxmas1.h"
+#include "../images/ussxmas2.h"
+#include "../images/ussxmas3.h"
+#include "../images/ussxmas4.h"
+
+// pictures shown in rotation, picnum 1 is the first one
+#define NUM_PICTURES 4
+const u08 * const pictures[NUM_PICTURES] = {
+  img_ussxmas1, img_ussxmas2, img_ussxmas3, img_ussxmas4
 };
-// End of Block 4
+// gamma and white balance for the pictures, from tools/gammalut,
+// run "make lut" there to change them
+#include "colorlut.h"
+// that and the brightness, the pictures go out as they're decoded
+rleLut pictureLut = { gamma_curve, color_white };
+
+#if NUM_PICTURES > PROF_MAX_PICTURES
+#error "raise PROF_MAX_PICTURES in profile.h"
+#endif
 
 
 /**************************************************
@@ -763,32 +239,100 @@ int main(void) {
    */
   uartInit();
   //uartSetBaudRate(9600);
+  set_output_chunk(OUTPUT_CHUNK(uartGetBaudRate()));
   
   /*************************
    * Command Protocol Library initialization stuff
    */
   // set library function to handle bytes received over UART (and other stuff)
   initCommandProtocolLibrary();
+  cmdTableInit(&cmdTableMain, cmdsMain, sizeof(cmdsMain)/sizeof(cmdsMain[0]), errCmd);
+  cmdTableInit(&cmdTableGet, cmdsGet, sizeof(cmdsGet)/sizeof(cmdsGet[0]), errGetNoProp);
+  
+  // the output routines scale by this, so the buffer can hold raw data
+  set_brightness(DEFAULT_BRIGHTNESS);
+  // no telling what the LEDs show at power up
+  mark_all_dirty();
+  set_power_budget(POWER_BUDGET_MA);
+  
+  // 'f' and 'c' commands stream pixel data into buf, target 0 is the upper string
+#ifdef WS2812_DUAL_LANE
+  setCommandProtocolStreamBuffer(0, buf, NUM_LEDS);
+  setCommandProtocolStreamBuffer(1, buf+NUM_LEDS, NUM_LEDS);
+#else
+  // only half a panel of buffer, both strings share it. What's before
+  // an 'f''s offset would be the other string's, so 'f' has to start at 0
+  setCommandProtocolStreamBuffer(0, buf, NUM_LEDS);
+  setCommandProtocolStreamBuffer(1, buf, NUM_LEDS);
+#endif
+  
+  // Timer1 counts for the frame build profile ('g' 't' cmd), and
+  // gives the scheduler its 1ms tick
+  profileInit();
+  schedInit();
+  schedSetFramePeriod(PICTURE_MS);
   
   // Globally Enable Interrupts
   // This MUST occur before ANY UART IO happens!!
   sei();
   
-  sprintf_P((char *)cmdprotprintbuf,PSTR("testing %d$"), CMDPROT_MY_ADDRESS);
-  uartSendBuffer(cmdprotprintbuf,strlen(cmdprotprintbuf));
+  rspStr_P(PSTR("testing "));
+  rspField(CMDPROT_MY_ADDRESS, '$');
+  sendMsg();
   
-  /* Loop forever, handle uart messages if we get any */
+  /* Loop forever, handle uart messages if we get any, and show the
+     slideshow whenever the scheduler says a frame is due */
   while (1) { 
     if (isCommandReady()) {
       PORTD |= (1 << PIND7); // DEBUG TURN ON RED LED INDICATOR
+      baudFallback = 0; // a cmd got through, so the current rate works
       beginCmdProcessing(); // follow command protocol
       processCmd(); // interpret the current waiting command
       endCmdProcessing(); // follow command protocol
+      if (baudNext) { // 'u' cmd: ack went out at the old rate, now switch
+        uartWaitTxDone();
+        baudFallback = uartGetBaudRate();
+        setBaudRate(baudNext);
+        baudNext = 0;
+        baudConfirmStart = schedMillis();
+      }
     }
     PORTD &= ~(1 << PIND7); // DEBUG TURN OFF RED LED INDICATOR
+    if (baudFallback) { // waiting for the master to talk at the new rate
+      if ((u16)(schedMillis() - baudConfirmStart) >= BAUD_CONFIRM_MS) {
+        setBaudRate(baudFallback);
+        baudFallback = 0;
+      }
+    }
+    // The output routines run with interrupts off for ~15ms, which
+    // would drop the bytes of a cmd coming in. Hold the frame back
+    // until it's in, it's late but not lost (overruns in 'g' 'f').
+    // a stream writes straight into buf, don't build anything over it
+    if (getStreamsBegun() != streamsSeen) {
+      streamsSeen = getStreamsBegun();
+      streamBegun();
+    }
+    if (rxByteCount != rxSeen) {
+      rxSeen = rxByteCount;
+      rxSeenMs = schedMillis();
+    }
+    if (isCommandReceiving() && ((u16)(schedMillis() - rxSeenMs) < CMD_HOLD_MS)) {
+      continue;
+    }
+    if (schedFrameDue()) {
+      if (marqueeOn) {
+        marqueeShow(TRUE);
+      } else {
+        refreshDisplay();
+      }
+    } else if (get_dither() && marqueeOn) {
+      marqueeShow(FALSE);
+    } else if (get_dither() && schedGetFramePeriod() && picnum) {
+      redrawDisplay(); // dithering needs every frame it can get
+    } else if (get_dither() && textShown) {
+      showText();
+    }
   }
-  loopRefreshingDisplay(); // put the old loop in a subroutine
-
 }
 
 /*********************************************************************
@@ -803,200 +347,748 @@ int main(void) {
  * unless this unit is stuck and does not respond within the specified 
  * response timeout time, 5ms.
  *
- * After successful command processing, send an ack message back to master.
+ * Each letter of the cmd is looked up in cmdTableMain, and its handler
+ * below does the work. After successful command processing, send an
+ * ack message back to master.
  *********************************************************************/
 void processCmd() {
-  u08 rc; // return code from handler funcs
-  // get a pointer to the data portion of RX buffer
-  cBuffer* myRxBufferPtr;
-  char * myRxBufferDataPtr;
-  myRxBufferPtr = uartGetRxBuffer();
-  myRxBufferDataPtr = myRxBufferPtr->dataptr;
-  
-  while (*myRxBufferDataPtr) { // do until we are at the null term (end of cmd)
-    switch(*myRxBufferDataPtr++) { // get a char and then increment ptr
-      // SET Address
-      case 'a':
-        rc = setCommandProtocolAddr(atoi((char *)myRxBufferDataPtr));
-        if (rc) {
-          sprintf_P(cmdprotprintbuf,PSTR("err-badaddr"));
-        }
-        // use EEPROM to store address between powerups. Only reprogram on non-global addr.
-        pointToNextNonNumericChar(&myRxBufferDataPtr);
-        break; // End 'a' command
-       
-      // Input Data String into a volatile variable on the arduino
-      case 'b': case 'B':
-        //; // "a label can only be a part of a statement" <= the following line declares a variable first
-        CRITICAL_SECTION_START;
-        setVolatileString(myRxBufferDataPtr);
-        myRxBufferDataPtr += strlen(myRxBufferDataPtr);
-        CRITICAL_SECTION_END;
-        break; // End 'b' command
-       
-      // Get info
-      case 'g': case 'G':
-        // Indicate to cmd protocol that we are sending a custom ack
-        // select sub-command
-        switch(*myRxBufferDataPtr++) {
-          case 'a': case 'A':
-            sprintf_P(cmdprotprintbuf, PSTR("g0x%02x$"), getCommandProtocolAddr());
-            // SPECIAL CASE!! we WANT to get the address back on a global command!
-            // You can only have ONE device on the net for this to work. Otherwise, user beware!
-            forceGlobalCmdResponse();
-            break;
-          
-          case 'b': case 'B':
-            sprintf_P(cmdprotprintbuf, PSTR("g%s$"), getVolatileString());
-            break;
-            
-          default:
-            sprintf_P(cmdprotprintbuf,PSTR("err-getnoprop$"));
-        }
-        break; // end 'g' command
-        
-      default:
-        sprintf_P(cmdprotprintbuf, PSTR("err-cmd$"));
-    } // end switch on command
-  } // end while more data
-}
-
-void setVolatileString(unsigned char *newString) {
-  // limit the copy to 
-  if (sizeof(newString) >= 39) { // sizeof does ptr len or string+null len??
-    strncpy((char *)&myVolatileStr, (char *)newString, 39);
+  while (cmdMore()) { // do until we are at the end of the cmd
+    cmdRun(&cmdTableMain);
+  }
+}
+
+// SET Address
+void handleAddr(u32 n) {
+  // use EEPROM to store address between powerups. Only reprogram on non-global addr.
+  if (setCommandProtocolAddr(n)) {
+    rspBegin();
+    rspStr_P(errBadAddr);
+  }
+}
+
+// Set brightness of the whole panel, 0-255
+void handleLevel(u32 n) {
+  set_brightness(n);
+}
+
+// Dither the brightness scaling, 0 = off. Smooth fades at a low
+// brightness, but the slideshow sends frames back to back for it
+void handleDither(u32 n) {
+  set_dither(n != 0);
+}
+
+// Power budget of each string in mA, 0 = no limit
+void handlePower(u32 n) {
+  set_power_budget(n);
+}
+
+// Change the baud rate. Acked at the old rate, then any cmd at the new
+// rate within BAUD_CONFIRM_MS keeps it, otherwise we fall back.
+void handleBaud(u32 n) {
+  if (!uartCheckBaudRate(n) || !OUTPUT_CHUNK_FITS(n)) {
+    baudNext = 0;
+    rspBegin();
+    rspStr_P(errBadBaud);
+  } else {
+    baudNext = n;
+    rspBegin();
+    rspChar('u');
+    rspField(baudNext, '$');
+  }
+}
+
+// Input Data String into a volatile variable on the arduino
+void handleString(u32 n) {
+  CRITICAL_SECTION_START;
+  cmdGetString(myVolatileStr, sizeof(myVolatileStr)); // the rest of the cmd, cut to fit
+  CRITICAL_SECTION_END;
+#ifndef WS2812_DUAL_LANE
+  if (shown[STRING_UPPER] == SHOWN_TEXT) { // it's another text now
+    shown[STRING_UPPER] = SHOWN_NONE;
+  }
+  if (shown[STRING_LOWER] == SHOWN_TEXT) {
+    shown[STRING_LOWER] = SHOWN_NONE;
+  }
+#endif
+  // and show it, instead of the slideshow. The marquee just
+  // carries on with the new one
+  if (!marqueeOn) {
+    schedSetFramePeriod(0);
+    showText();
+  }
+}
+
+// Marquee: scroll the 'b' string, a column every this many ms, 0 for
+// MARQUEE_MS. A new 'b' string scrolls on, 'f' and 's' end it
+void handleMarquee(u32 n) {
+  marqueeStart(n);
+}
+
+// Slideshow: show each picture this many ms, 0 stops it
+void handleSlideshow(u32 n) {
+  marqueeStop();
+  schedSetFramePeriod(n);
+}
+
+// a stream is coming into buf, stop whatever draws there
+void streamBegun(void) {
+  schedSetFramePeriod(0); // stop the slideshow, it would draw over this
+  marqueeStop();
+  textShown = FALSE;
+#ifndef WS2812_DUAL_LANE
+  framePic = 0;
+#endif
+}
+
+// TRUE if a stream is coming into buf, or began since the main loop
+// last looked. Nothing may be built there then, ask before starting.
+u08 bufBusy(void) {
+  if ((getStreamsBegun() == streamsSeen) && !isStreamReceiving()) {
+    return FALSE;
+  }
+  streamBegun();
+  return TRUE;
+}
+
+// TRUE if a stream began since getStreamsBegun() was streams, that is
+// while buf was being built, bytes from to to-1 of it. The frame is
+// dropped and nothing draws in buf any more. The stream is only
+// answered as bad, for the master to send again, if the build wrote
+// where it had already put data.
+u08 buildSpoiled(u08 streams, u16 from, u16 to) {
+  u16 start, end; // what the stream has written so far, in buf
+
+  if (getStreamsBegun() == streams) {
+    return FALSE;
+  }
+  CRITICAL_SECTION_START;
+  start = getStreamStart();
+  end = start + getStreamLength();
+  CRITICAL_SECTION_END;
+#ifdef WS2812_DUAL_LANE
+  start += getStreamTarget()*NUM_LEDS; // see main()
+  end += getStreamTarget()*NUM_LEDS;
+#endif
+  if ((start < end) && (from < end) && (start < to)) {
+    setStreamError();
+  }
+  streamBegun();
+  return TRUE;
+}
+
+// take what an 'f' or 'c' streamed into buf, and send it out unless
+// there are 'c' chunks still to come again
+void streamTaken(void) {
+  streamBegun();
+  // only send the target string, and only up to the last byte streamed
+  mark_dirty(getStreamTarget(), getStreamStart() + getStreamLength());
+#ifdef WS2812_DUAL_LANE
+  power_measure(getStreamTarget(), buf + getStreamTarget()*NUM_LEDS);
+  if (!getStreamNaks()) {
+    output_grb34_dirty(buf);
+  }
+#else
+  power_measure(getStreamTarget(), buf);
+  shown[getStreamTarget()] = SHOWN_NONE;
+  if (getStreamNaks()) {
+    // held back. One buf for both strings, so the master has to get
+    // this string right before it starts on the other one
+  } else if (getStreamTarget() == 0) {
+    output_grb3_dirty(buf);
   } else {
-    strcpy((char *)&myVolatileStr, (char *)newString);
-  }  
+    output_grb4_dirty(buf);
+  }
+#endif
+}
+
+// Stream GRB data, already decoded into buf by the rx ISR. Show it, and
+// reply with the number of bytes taken
+void handleStream(u32 n) {
+#ifndef WS2812_DUAL_LANE
+  if (getStreamStart()) { // see setCommandProtocolStreamBuffer() in main()
+    setStreamError();
+  }
+#endif
+  if (getStreamError()) {
+    rspBegin();
+    rspStr_P(errStream);
+    return;
+  }
+  streamTaken();
+  rspBegin();
+  rspChar('f');
+  rspField(getStreamLength(), '$');
+}
+
+// A checked chunk: ack it, or nak it so the master sends just it again.
+// A bad header gets a nak without the seq, it could be anyone's
+void handleChunk(u32 n) {
+  u08 check = checkStreamChunk();
+
+  rspBegin();
+  if (check == CMDPROT_CHUNK_RANGE) {
+    rspStr_P(errStream); // sending it again won't help
+    return;
+  }
+  if (check == CMDPROT_CHUNK_OK) {
+    streamTaken();
+    rspChar('c');
+  } else {
+    rspChar('n');
+  }
+  if (check != CMDPROT_CHUNK_NAKHDR) {
+    rspDec(getStreamSeq());
+  }
+  rspChar('$');
+}
+
+// Get info, the next letter says what, see cmdTableGet
+void handleGet(u32 n) {
+  cmdRun(&cmdTableGet);
 }
 
-unsigned char * getVolatileString(void) {
-  return &myVolatileStr;
+void replyAddr(u32 n) {
+  rspBegin();
+  rspStr_P(PSTR("g0x"));
+  rspHex(getCommandProtocolAddr());
+  rspChar('$');
+  // SPECIAL CASE!! we WANT to get the address back on a global command!
+  // You can only have ONE device on the net for this to work. Otherwise, user beware!
+  forceGlobalCmdResponse();
 }
 
-void loopRefreshingDisplay(void) {
+void replyString(u32 n) {
+  rspBegin();
+  rspChar('g');
+  rspStr(getVolatileString());
+  rspChar('$');
+}
+
+void replyLevel(u32 n) {
+  rspBegin();
+  rspChar('g');
+  rspField(get_brightness(), '$');
+}
+
+void replyDither(u32 n) {
+  rspBegin();
+  rspChar('g');
+  rspField(get_dither() ? 1 : 0, '$');
+}
+
+// power: budget, then upper and lower string estimated mA and brightness limit
+void replyPower(u32 n) {
+  rspBegin();
+  rspChar('g');
+  rspField(get_power_budget(), ',');
+  rspField(get_power_estimate(STRING_UPPER), ',');
+  rspField(get_power_estimate(STRING_LOWER), ',');
+  rspField(get_power_limit(STRING_UPPER), ',');
+  rspField(get_power_limit(STRING_LOWER), '$');
+}
+
+// uart errors: buffer overflows, framing, overruns
+void replyErrors(u32 n) {
+  rspBegin();
+  rspChar('g');
+  rspField(uartRxOverflow, ',');
+  rspField(uartRxFrameErrors, ',');
+  rspField(uartRxOverruns, '$');
+}
+
+// frame scheduler: period ms, frames, overruns
+void replyFrames(u32 n) {
+  rspBegin();
+  rspChar('g');
+  rspField(schedGetFramePeriod(), ',');
+  rspField(schedGetFrames(), ',');
+  rspField(schedGetOverruns(), '$');
+}
+
+// output: chunk bytes, longest interrupts off and longest gap, in cycles
+void replyOutput(u32 n) {
+  rspBegin();
+  rspChar('g');
+  rspField(get_output_chunk(), ',');
+  rspField(PROF_CYCLES(get_output_cli_max()), ',');
+  rspField(PROF_CYCLES(get_output_gap_max()), '$');
+  clear_output_max();
+}
+
+// frame profile of slot n: frames, then build and output cycles, last and max
+void replyProfile(u32 n) {
+  const profSlot *prof = profileGet(n);
 
-  // temporary holders for color data, for loading from pgm mem into buffer.
-  u08 tempR;
-  u08 tempG;
-  u08 tempB;
-  u16 i; // common loop iterator, used for clearing and setting buffer
-  u08 div = 10; // divide brightness of raw data by this num
-  u08 picnum = 1; // start on 1st image
+  rspBegin();
+  rspChar('g');
+  rspField(prof->frames, ',');
+  rspField(PROF_CYCLES(prof->last[PROF_BUILD]), ',');
+  rspField(PROF_CYCLES(prof->max[PROF_BUILD]), ',');
+  rspField(PROF_CYCLES(prof->last[PROF_OUTPUT]), ',');
+  rspField(PROF_CYCLES(prof->max[PROF_OUTPUT]), '$');
+}
+
+/*********************************************************************
+ * setBaudRate:
+ *
+ * Change the uart rate, and size the output chunks to go with it.
+ *********************************************************************/
+void setBaudRate(u32 baudrate) {
+  uartSetBaudRate(baudrate);
+  set_output_chunk(OUTPUT_CHUNK(baudrate));
+}
+
+char * getVolatileString(void) {
+  return myVolatileStr;
+}
 
-  /* Loop forever refreshing the display rotating between 4 images */
-  while (1) {
-    /* Build buffer from array data, 1st half!! */
-    
-    // clear buffer
-    for (i=0;i<NUM_LEDS;i++) {
-      buf[i]=0;
+/*********************************************************************
+ * fillBufferHalf:
+ *
+ * Decode one string's worth of picture data (NUM_WS2812 pixels, from
+ * pixel 'start') into halfbuf in GRB string order. Colors go through
+ * pictureLut on the way (gamma, white balance and brightness, rounded
+ * once), so the string goes out with set_output_scaled().
+ *
+ * Adds up the bytes for the string's power estimate, and marks what the
+ * string needs sent. With the whole panel in buf that is
+ * up to the last byte that changed. With half a panel buf holds the
+ * other string's data, so it all goes unless the string shows this
+ * picture already.
+ *********************************************************************/
+void fillBufferHalf(u08 *halfbuf, u08 picnum, u16 start) {
+  
+  rleCursor pic; // decoder position in the picture
+  const u08 *grb; // color of the current pixel
+  u16 i; // common loop iterator
+  u08 string = (start == 0) ? STRING_UPPER : STRING_LOWER;
+  u32 sum = 0; // of all bytes, for the power estimate
+#ifdef WS2812_DUAL_LANE
+  u16 changed = 0; // bytes up to the last one that changed
+#else
+  framePic = 0; // written over
+#endif
+  
+  rleLutLevel(&pictureLut, get_brightness());
+  rleImageBegin(&pic, pictures[picnum-1]);
+  rleImageSetLut(&pic, &pictureLut);
+  rleImageSkip(&pic, start);
+  
+  // picture pixels run row by row, pixel_map puts each one on its LED
+  for (i=start;i<start+NUM_WS2812;i++) {
+    grb = rleImageNext(&pic);
+    bufindex = 3*(pgm_read_word(&pixel_map[i]) - start);
+#ifdef WS2812_DUAL_LANE
+    if ((halfbuf[bufindex] != grb[0]) || (halfbuf[bufindex+1] != grb[1]) || (halfbuf[bufindex+2] != grb[2])) {
+      if (bufindex+3 > changed) {
+        changed = bufindex+3;
+      }
     }
-    
-    // begin at top of buffer, work back to 0
-    bufindex = 120;
-    
-    for (i=0;i<NUM_LEDS;) { // i is incremented +3 each loop
-      //fill temp values of BGR from curr pic
-      switch (picnum) {
-        case 1:
-        tempB = pgm_read_byte(&(block1[i++]));
-        tempG = pgm_read_byte(&(block1[i++]));
-        tempR = pgm_read_byte(&(block1[i++]));
-        break;
-        case 2:
-        tempB = pgm_read_byte(&(block2[i++]));
-        tempG = pgm_read_byte(&(block2[i++]));
-        tempR = pgm_read_byte(&(block2[i++]));
-        break;
-        case 3:
-        tempB = pgm_read_byte(&(block3[i++]));
-        tempG = pgm_read_byte(&(block3[i++]));
-        tempR = pgm_read_byte(&(block3[i++]));
-        break;
-        case 4:
-        tempB = pgm_read_byte(&(block4[i++]));
-        tempG = pgm_read_byte(&(block4[i++]));
-        tempR = pgm_read_byte(&(block4[i++]));
-        break;
+#endif
+    halfbuf[bufindex++] = grb[0];
+    halfbuf[bufindex++] = grb[1];
+    halfbuf[bufindex] = grb[2];
+    sum += (u16)grb[0] + grb[1] + grb[2];
+  }
+  // the estimate wants the bytes before the brightness
+  if (get_brightness()) {
+    sum = sum*255/get_brightness();
+  }
+  power_string(string, sum); // before markIfNew, it may mark the string
+#ifdef WS2812_DUAL_LANE
+  mark_dirty(string, changed);
+#else
+  markIfNew(string, picnum);
+#endif
+}
+
+#ifndef WS2812_DUAL_LANE
+/*********************************************************************
+ * markIfNew:
+ *
+ * With half a panel of buffer: what was just built for a string, a
+ * picnum or SHOWN_TEXT. Send all of it, unless the string shows that
+ * already.
+ *********************************************************************/
+void markIfNew(u08 string, u08 what) {
+  if (what != shown[string]) {
+    mark_dirty(string, NUM_LEDS);
+    shown[string] = what;
+  }
+}
+
+/*********************************************************************
+ * palFits:
+ *
+ * TRUE if picture picnum can go out as palette indices: all 16 colors
+ * in its palette, so no literal runs, and uart chunks of two LEDs or
+ * more. Else it's decoded to GRB a string at a time.
+ *********************************************************************/
+u08 palFits(u08 picnum) {
+  return (pgm_read_byte(&pictures[picnum-1][2]) == 16) && output_pal4_fits();
+}
+
+/*********************************************************************
+ * fillPalFrame:
+ *
+ * Decode picture picnum into buf as 4 bit palette indices, both
+ * strings at once (NUM_WS2812/2 bytes each, the first LED in the high
+ * nibble). Nothing is decoded if buf holds it already, so dithering
+ * only rebuilds pictureLut's 16 colors each frame. Then each string
+ * gets its power estimate and is marked as for fillBufferHalf().
+ *********************************************************************/
+void fillPalFrame(u08 picnum) {
+
+  rleCursor pic; // decoder position in the picture
+  u16 i, led;
+  u08 index, string;
+  u08 *p;
+
+  rleLutLevel(&pictureLut, get_brightness());
+  rleLutImage(&pictureLut, pictures[picnum-1]);
+  if (framePic != picnum) {
+    rleImageBegin(&pic, pictures[picnum-1]);
+    for (i=0;i<PANEL_PIXELS;i++) {
+      index = rleImageNextIndex(&pic);
+      led = pgm_read_word(&pixel_map[i]);
+      p = &buf[led/2];
+      if (led & 1) {
+        *p = (*p & 0xF0) | index;
+      } else {
+        *p = (*p & 0x0F) | (index << 4);
       }
-      
-      // use div to reduce max brightness
-      tempR = tempR/div;
-      tempG = tempG/div;
-      tempB = tempB/div;
-      
-      //put values in buffer, in the correct order
-      bufindex--;
-      buf[bufindex] = tempB;
-      bufindex--;
-      buf[bufindex] = tempR;
-      bufindex--;
-      buf[bufindex] = tempG;
     }
-    output_grb3(buf, sizeof(buf));
-    
-    
-    
-    /* Build buffer from array data, 2nd half!! */
-    //reinit for second half
-    for (i=0;i<NUM_LEDS;i++) {
-      buf[i]=0;
+    framePic = picnum;
+  }
+  for (string = STRING_UPPER; string <= STRING_LOWER; string++) {
+    powerPalString(string, buf + string*(NUM_WS2812/2));
+    markIfNew(string, picnum);
+  }
+}
+
+/*********************************************************************
+ * powerPalString:
+ *
+ * Power estimate for a string of palette indices: how many LEDs have
+ * each color, times its bytes out of pictureLut. Same sum as
+ * fillBufferHalf() gets from the GRB bytes.
+ *********************************************************************/
+void powerPalString(u08 string, const u08 *idx) {
+
+  u16 count[16]; // LEDs with each palette index
+  const u08 *grb = pictureLut.color;
+  u32 sum = 0;
+  u16 i;
+
+  memset(count, 0, sizeof(count));
+  for (i=0;i<NUM_WS2812/2;i++) {
+    count[idx[i] >> 4]++;
+    count[idx[i] & 0x0F]++;
+  }
+  for (i=0;i<16;i++, grb+=3) {
+    sum += (u32)count[i]*((u16)grb[0] + grb[1] + grb[2]);
+  }
+  // the estimate wants the bytes before the brightness
+  if (get_brightness()) {
+    sum = sum*255/get_brightness();
+  }
+  power_string(string, sum);
+}
+#endif
+
+/*********************************************************************
+ * refreshDisplay:
+ *
+ * Move on to the next picture and show it. The main loop calls this
+ * when the scheduler says a frame is due.
+ *********************************************************************/
+void refreshDisplay(void) {
+
+  textShown = FALSE;
+  marqueeStop();
+
+  // sel next picture data
+  if (picnum < NUM_PICTURES){
+    picnum++;
+    } else {
+    picnum = 1;
+  }
+  redrawDisplay();
+}
+
+/*********************************************************************
+ * redrawDisplay:
+ *
+ * Show picture picnum on the panel. Only what changed goes out, unless
+ * dithering wants the whole frame again.
+ *
+ * With half a panel of buffer a picture is kept in buf as palette
+ * indices if it can be (palFits()), so both strings are built once
+ * and a dithered redraw only sends them again.
+ *********************************************************************/
+void redrawDisplay(void) {
+
+  u16 t; // profile time stamp
+  u08 streams = getStreamsBegun();
+#ifndef WS2812_DUAL_LANE
+  u16 built; // bytes of buf the palette frame writes
+#endif
+
+  if (bufBusy()) {
+    return;
+  }
+  dither_frame();
+  // no dithering: round to nearest
+  rleLutDither(&pictureLut, get_dither() ? get_dither_phase() : 0x80, get_dither_step());
+
+#ifdef WS2812_DUAL_LANE
+  /* Build both halves, then send them out together */
+  t = profileStart();
+  fillBufferHalf(buf, picnum, 0);
+  fillBufferHalf(buf+NUM_LEDS, picnum, NUM_WS2812);
+  profileStop(PROF_BUILD, t);
+  if (buildSpoiled(streams, 0, sizeof(buf))) {
+    return;
+  }
+  t = profileStart();
+  set_output_scaled(TRUE);
+  output_grb34_dirty(buf);
+  set_output_scaled(FALSE);
+  profileStop(PROF_OUTPUT, t);
+#else
+  if (palFits(picnum)) {
+    /* Whole frame as palette indices, the colors go out of pictureLut */
+    built = (framePic == picnum) ? 0 : NUM_WS2812;
+    t = profileStart();
+    fillPalFrame(picnum);
+    profileStop(PROF_BUILD, t);
+    if (buildSpoiled(streams, 0, built)) {
+      return;
     }
-    
-    //fill buffer with second half of array
-    bufindex = 120;
-    
-    for (i=NUM_LEDS;i<NUM_LEDS*2;) { // i is incremented +3 each loop
-      //fill temp values of colors
-      switch (picnum) {
-        case 1:
-        tempB = pgm_read_byte(&(block1[i++]));
-        tempG = pgm_read_byte(&(block1[i++]));
-        tempR = pgm_read_byte(&(block1[i++]));
-        break;
-        case 2:
-        tempB = pgm_read_byte(&(block2[i++]));
-        tempG = pgm_read_byte(&(block2[i++]));
-        tempR = pgm_read_byte(&(block2[i++]));
-        break;
-        case 3:
-        tempB = pgm_read_byte(&(block3[i++]));
-        tempG = pgm_read_byte(&(block3[i++]));
-        tempR = pgm_read_byte(&(block3[i++]));
-        break;
-        case 4:
-        tempB = pgm_read_byte(&(block4[i++]));
-        tempG = pgm_read_byte(&(block4[i++]));
-        tempR = pgm_read_byte(&(block4[i++]));
-        break;
-      }
-      tempR = tempR/div;
-      tempG = tempG/div;
-      tempB = tempB/div;
-      
-      //put values in buffer, in the correct order
-      bufindex--;
-      buf[bufindex] = tempB;
-      bufindex--;
-      buf[bufindex] = tempR;
-      bufindex--;
-      buf[bufindex] = tempG;
+    t = profileStart();
+    output_grb_pal4_dirty(STRING_UPPER, buf, pictureLut.color);
+    if (buildSpoiled(streams, 0, 0)) { // it may have come in between chunks
+      return;
     }
-    //output second half
-    output_grb4(buf, sizeof(buf));
-    
-
-    
-    // sel next picture data
-    if (picnum < 4){
-      picnum++;
-      } else {
-      picnum = 1;
+    output_grb_pal4_dirty(STRING_LOWER, buf + NUM_WS2812/2, pictureLut.color);
+    profileStop(PROF_OUTPUT, t);
+    profileFrame(PROF_PICTURE(picnum));
+    return;
+  }
+
+  /* Build buffer from array data, 1st half!! */
+  t = profileStart();
+  fillBufferHalf(buf, picnum, 0);
+  profileStop(PROF_BUILD, t);
+  if (buildSpoiled(streams, 0, NUM_LEDS)) {
+    return;
+  }
+  t = profileStart();
+  set_output_scaled(TRUE);
+  output_grb3_dirty(buf);
+  set_output_scaled(FALSE);
+  profileStop(PROF_OUTPUT, t);
+  
+  /* Build buffer from array data, 2nd half!! */
+  t = profileStart();
+  fillBufferHalf(buf, picnum, NUM_WS2812);
+  profileStop(PROF_BUILD, t);
+  if (buildSpoiled(streams, 0, NUM_LEDS)) {
+    return;
+  }
+  //output second half
+  t = profileStart();
+  set_output_scaled(TRUE);
+  output_grb4_dirty(buf);
+  set_output_scaled(FALSE);
+  profileStop(PROF_OUTPUT, t);
+#endif
+  profileFrame(PROF_PICTURE(picnum));
+}
+
+/*********************************************************************
+ * showText:
+ *
+ * Show the 'b' string on one line across the middle of the panel,
+ * centered. It's in the 5x7 font if it fits, else in the 3x5 one, and
+ * cut off on the right if that's still too long.
+ *
+ * With the whole panel in buf, only the pixels that changed since the
+ * last string go out. With half a panel each string is built and
+ * checked in turn, and only goes out if it shows something else.
+ *********************************************************************/
+void showText(void) {
+
+  const char *s = getVolatileString();
+  s16 x, y;
+  u08 streams = getStreamsBegun();
+#ifndef WS2812_DUAL_LANE
+  u08 string;
+  u16 was;
+#endif
+
+  if (bufBusy()) {
+    return;
+  }
+  textSt.f = (fontTextWidth(&font5x7, s) <= XBOUND+1) ? &font5x7 : &font3x5;
+  x = ((s16)XBOUND + 1 - (s16)fontTextWidth(textSt.f, s)) / 2; // the last blank column doesn't count
+  if (x < 0) {
+    x = 0;
+  }
+  y = (2*YBOUND + textSt.f->height)/2 - 1;
+  marqueeStop();
+  dither_frame();
+#ifdef WS2812_DUAL_LANE
+  if (!textShown) { // clear whatever was there
+    memset(buf, 0, sizeof(buf));
+    mark_all_dirty();
+  }
+  fontDrawText(buf, 0, PANEL_PIXELS, &textSt, s, x, y);
+  if (buildSpoiled(streams, 0, sizeof(buf))) {
+    return;
+  }
+  power_measure(STRING_UPPER, buf);
+  power_measure(STRING_LOWER, buf+NUM_LEDS);
+  output_grb34_dirty(buf);
+#else
+  framePic = 0;
+  for (string = STRING_UPPER; string <= STRING_LOWER; string++) {
+    was = get_dirty(string);
+    memset(buf, 0, sizeof(buf));
+    fontDrawText(buf, string*NUM_WS2812, NUM_WS2812, &textSt, s, x, y);
+    if (buildSpoiled(streams, 0, sizeof(buf))) {
+      return;
+    }
+    set_dirty(string, was); // it was drawn over other data, the marks mean nothing
+    markIfNew(string, SHOWN_TEXT);
+    power_measure(string, buf);
+    if (string == STRING_UPPER) {
+      output_grb3_dirty(buf);
+    } else {
+      output_grb4_dirty(buf);
     }
-    
-    // delay 1 second before rendering the next image
-    _delay_ms(1000);
-    
-  } // end WHILE 1 loop
-}
\ No newline at end of file
+  }
+#endif
+  textShown = TRUE;
+}
+
+/*********************************************************************
+ * marqueeStart:
+ *
+ * Scroll the 'b' string across the panel, right to left, one column
+ * every ms (0 for MARQUEE_MS), and round again. The panel goes black
+ * and the text comes in from the right.
+ *********************************************************************/
+void marqueeStart(u16 ms) {
+
+  marqueeStop();
+  memset(buf, 0, sizeof(buf));
+  mark_all_dirty();
+  textShown = FALSE;
+  textSt.f = &font5x7;
+  marqueeCol = 0;
+  marqueeOn = TRUE;
+#ifdef WS2812_DUAL_LANE
+  power_measure(STRING_UPPER, buf);
+  power_measure(STRING_LOWER, buf+NUM_LEDS);
+  output_grb34_dirty(buf);
+#else
+  // both strings black, then buf only holds the marquee's
+  power_measure(STRING_UPPER, buf);
+  output_grb3_dirty(buf);
+  power_measure(STRING_LOWER, buf);
+  output_grb4_dirty(buf);
+  shown[STRING_UPPER] = SHOWN_NONE;
+  shown[STRING_LOWER] = SHOWN_NONE;
+  framePic = 0;
+#endif
+  schedSetFramePeriod(ms ? ms : MARQUEE_MS);
+}
+
+/*********************************************************************
+ * marqueeStop:
+ *
+ * Back to a plain buffer for whatever comes next. What the marquee left
+ * in buf is out of order then, but all of it is marked to go out again.
+ *********************************************************************/
+void marqueeStop(void) {
+
+  if (marqueeOn) {
+    marqueeOn = FALSE;
+    set_column_offset(0);
+  }
+}
+
+/*********************************************************************
+ * marqueeShow:
+ *
+ * One step of the marquee, or the same frame again for the dithering.
+ *
+ * buf is a ring of columns (set_column_offset in WS2812.h): a step moves
+ * the offset on, and only the new column on the right is drawn, so a
+ * step costs one column whatever the width of the panel. Only the
+ * marquee's string goes out, the other one stays black.
+ *********************************************************************/
+void marqueeShow(u08 step) {
+
+  const char *s = getVolatileString();
+  u08 *p = buf; // the marquee string's data
+  u08 x; // buffer column of the new column
+  s16 y = MARQUEE_STRING*YBOUND + (YBOUND + textSt.f->height)/2 - 1; // its top row
+  u32 sum;
+  u16 t; // profile time stamp
+  u08 streams = getStreamsBegun();
+
+#ifdef WS2812_DUAL_LANE
+  p += MARQUEE_STRING*NUM_LEDS;
+#endif
+  if (bufBusy()) {
+    return;
+  }
+  dither_frame();
+  t = profileStart();
+  if (step) {
+    if (marqueeCol >= fontTextWidth(textSt.f, s) + MARQUEE_GAP) {
+      marqueeCol = 0;
+    }
+    set_column_offset(get_column_offset() + 1);
+    x = column_x(XBOUND-1); // where the column that went off the left was
+    // the power estimate only changes by the column that's replaced
+    sum = get_power_sum(MARQUEE_STRING) - marqueeColumnSum(p, x, y);
+    fontDrawColumn(p, MARQUEE_STRING*NUM_WS2812, NUM_WS2812, &textSt,
+                   fontTextColumn(textSt.f, s, marqueeCol++), x, y);
+    power_string(MARQUEE_STRING, sum + marqueeColumnSum(p, x, y));
+  }
+  set_dirty(MARQUEE_STRING ^ 1, 0); // all black, it looks the same at any offset
+  profileStop(PROF_BUILD, t);
+  if (buildSpoiled(streams, step ? p-buf : 0, step ? p-buf+NUM_LEDS : 0)) {
+    return;
+  }
+  t = profileStart();
+  if (MARQUEE_STRING == STRING_UPPER) {
+    output_grb3_dirty(p);
+  } else {
+    output_grb4_dirty(p);
+  }
+  profileStop(PROF_OUTPUT, t);
+  profileFrame(PROF_MARQUEE);
+}
+
+/*********************************************************************
+ * marqueeColumnSum:
+ *
+ * Sum of the bytes of the marquee's text rows in buffer column x, for
+ * the power estimate.
+ *********************************************************************/
+u16 marqueeColumnSum(const u08 *p, u08 x, s16 y) {
+
+  u16 sum = 0;
+  u08 row;
+  const u08 *led;
+
+  for (row = 0; row < textSt.f->height; row++) {
+    led = p + 3*(pixel_led(x, y - row) - MARQUEE_STRING*NUM_WS2812);
+    sum += led[0] + led[1] + led[2];
+  }
+  return sum;
+}
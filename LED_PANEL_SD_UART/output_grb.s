@@ -4,13 +4,21 @@
  ;extern void output_grb(u08 * ptr, u16 count)
  ;
  ; r18 = data byte
- ; r19 = 7-bit count
+ ; r19 = 8-bit count
  ; r20 = 1 output
  ; r21 = 0 output
  ; r22 = SREG save
+ ; r23 = middle edge output
  ; r24:25 = 16-bit count
  ; r26:27 (X) = data pointer
 
+ ; Every bit is 20 cycles, high for 6 ('0') or 12 ('1'): 375ns or 750ns
+ ; high, 875ns or 500ns low at 16MHz. The last bit of a byte runs 4
+ ; cycles longer while the next byte is fetched. tools/wstiming runs
+ ; this on a simulator against the WS2812B datasheet windows, "make
+ ; check" there after changing anything below.
+ ; 164 cycles per byte, so a 1320 byte string takes 13.5ms at 16MHz.
+
  .equ      OUTBIT,   3
 
 
@@ -21,76 +29,37 @@
  in     r22, SREG     ;save SREG (global int state)
  cli                  ;no interrupts from here on, we're cycle-counting
  in     r20, PORTD
- nop
  ori    r20, (1<<OUTBIT)         ;our '1' output
- nop
  in     r21, PORTD
- nop
  andi   r21, ~(1<<OUTBIT)        ;our '0' output
- nop
- ldi    r19, 7        ;7 bit counter (8th bit is different)
- nop
+ ldi    r19, 8        ;bit counter
  ld     r18,X+        ;get first data byte
- nop
  loop1:
  out    PORTD, r20    ; 1   +0 start of a bit pulse
- nop
- lsl    r18           ; 1   +1 next bit into C, MSB first
- nop
- brcs   L1            ; 1/2 +2 branch if 1
- nop
- out    PORTD, r21    ; 1   +3 end hi for '0' bit (3 clocks hi)
- nop
- nop                  ; 1   +4
- nop
- bst    r18, 7        ; 1   +5 save last bit of data for fast branching
- nop
- subi   r19, 1        ; 1   +6 how many more bits for this byte?
- nop
- breq   bit8          ; 1/2 +7 last bit, do differently
- nop
- rjmp   loop1         ; 2   +8, 10 total for 0 bit
- nop
- L1:
- nop                  ; 1   +4
- nop
- bst    r18, 7        ; 1   +5 save last bit of data for fast branching
- nop
- subi   r19, 1        ; 1   +6 how many more bits for this byte
- nop
- out    PORTD, r21    ; 1   +7 end hi for '1' bit (7 clocks hi)
- nop
- brne   loop1         ; 2/1 +8 10 total for 1 bit (fall thru if last bit)
- nop
+ mov    r23, r21      ; 1   +1 assume a '0' bit
+ sbrc   r18, 7        ; 1/2 +2
+ mov    r23, r20      ; 1   +3 '1' bit, stay high at the middle edge
+ lsl    r18           ; 1   +4 next bit up, MSB first
+ nop                  ; 1   +5
+ out    PORTD, r23    ; 1   +6 end hi for '0' bit (6 clocks hi)
+ nop                  ; 1   +7
+ nop                  ; 1   +8
+ nop                  ; 1   +9
+ nop                  ; 1   +10
+ nop                  ; 1   +11
+ out    PORTD, r21    ; 1   +12 end hi for '1' bit (12 clocks hi)
+ dec    r19           ; 1   +13 how many more bits for this byte?
+ breq   bit8          ; 1/2 +14 last bit, fetch the next byte
+ nop                  ; 1   +15
+ nop                  ; 1   +16
+ nop                  ; 1   +17
+ rjmp   loop1         ; 2   +18, 20 total per bit
  bit8:
- ldi    r19, 7        ; 1   +9 bit count for next byte
- nop
- out    PORTD, r20    ; 1   +0 start of a bit pulse
- nop
- brts   L2            ; 1/2 +1 branch if last bit is a 1
- nop
- nop                  ; 1   +2
- nop
- out    PORTD, r21    ; 1   +3 end hi for '0' bit (3 clocks hi)
- nop
- ld     r18, X+       ; 2   +4 fetch next byte
- nop
- sbiw   r24, 1        ; 2   +6 dec byte counter
- nop
- brne   loop1         ; 2   +8 loop back or return
- nop
+ sbiw   r24, 1        ; 2   +16 dec byte counter
+ breq   done          ; 1/2 +18 all done?
+ ld     r18, X+       ; 2   +19 fetch next byte
+ ldi    r19, 8        ; 1   +21 bit count for next byte
+ rjmp   loop1         ; 2   +22, 24 total for last bit of a byte
+ done:
  out    SREG, r22     ; restore global int flag
- nop
  ret
- L2:
- ld     r18, X+       ; 2   +3 fetch next byte
- nop
- sbiw   r24, 1        ; 2   +5 dec byte counter
- nop
- out    PORTD, r21    ; 1   +7 end hi for '1' bit (7 clocks hi)
- nop
- brne   loop1         ; 2   +8 loop back or return
- nop
- out    SREG, r22     ; restore global int flag
- ret
-
@@ -0,0 +1,136 @@
+ #define __SFR_OFFSET 0
+ #include <avr/io.h>
+
+ ;extern void output_grb34(u08 * ptr, u16 count)
+ ;extern void output_grb34s(u08 * ptr, u16 count, u16 stride)
+ ;
+ ; Dual-lane version of output_grb3/output_grb4. Both strings are clocked
+ ; out in the same bit loop, so the whole panel goes out in the time it
+ ; used to take for one half.
+ ;
+ ; ptr points at 2*count bytes: the PD3 (upper) string's data first, the
+ ; PD4 (lower) string's data directly after it at ptr+count.
+ ; output_grb34s takes the lower string's data from ptr+stride instead,
+ ; so part of a buffer can go out (WS2812.c chunked output).
+ ;
+ ; Every bit starts with both lanes high. At +6 the lanes sending a '0'
+ ; drop, at +12 the lanes sending a '1' drop. The '0'/'1' pattern for the
+ ; middle edge is built with bst/bld so there are no branches in the bit.
+ ;
+ ; r17 = brightness (255 = full), from led_brightness (pushed)
+ ; r18 = PD3 lane data byte
+ ; r19 = PD4 lane data byte
+ ; r20 = both lanes '1' output
+ ; r21 = both lanes '0' output
+ ; r22 = 8-bit count
+ ; r23 = middle edge output ('1' lanes still high)
+ ; r0:r1 = mul result, r1 is cleared before returning
+ ; r14 = 0, for adding the carry (pushed)
+ ; r15 = dither step, from led_dither_step (pushed)
+ ; r16 = dither threshold, from led_dither, stored back when done (pushed)
+ ; r24:25 = 16-bit count (bytes per lane)
+ ; r26:27 (X) = PD3 lane data pointer
+ ; r30:31 (Z) = PD4 lane data pointer
+ ;
+ ; Dithering as in output_grb3, the threshold steps on after each byte,
+ ; upper lane byte first.
+
+ ; tools/wstiming runs this on a simulator against the WS2812B datasheet
+ ; windows, "make check" there after changing anything below.
+ ; 177 cycles per byte pair plus 64, so both 1320 byte strings take
+ ; 14.6ms at 16MHz.
+
+ .equ      OUTBITA,  3
+ .equ      OUTBITB,  4
+
+
+ .global output_grb34s
+ output_grb34s:
+ movw   r30, r24
+ add    r30, r20
+ adc    r31, r21      ;r30:31 = Z = p_buf+stride (lower lane)
+ rjmp   start
+
+ .global output_grb34
+ output_grb34:
+ movw   r30, r24
+ add    r30, r22
+ adc    r31, r23      ;r30:31 = Z = p_buf+count (lower lane)
+ start:
+ movw   r26, r24      ;r26:27 = X = p_buf (upper lane)
+ movw   r24, r22      ;r24:25 = count
+ push   r17
+ lds    r17, led_brightness ;global brightness, applied to each byte
+ push   r16
+ lds    r16, led_dither
+ push   r15
+ lds    r15, led_dither_step
+ push   r14
+ clr    r14
+ in     r0, SREG      ;save SREG (global int state)
+ push   r0
+ cli                  ;no interrupts from here on, we're cycle-counting
+ in     r20, PORTD
+ ori    r20, (1<<OUTBITA)|(1<<OUTBITB) ;both lanes '1'
+ in     r21, PORTD
+ andi   r21, ~((1<<OUTBITA)|(1<<OUTBITB)) ;both lanes '0'
+ ldi    r22, 8        ;bit counter
+ ld     r18, X+       ;get first data byte, upper lane
+ ld     r19, Z+       ;get first data byte, lower lane
+ mul    r18, r17      ;scale by brightness
+ mov    r18, r1
+ add    r0, r16       ;dither
+ adc    r18, r14
+ add    r16, r15
+ mul    r19, r17
+ mov    r19, r1
+ add    r0, r16
+ adc    r19, r14
+ add    r16, r15
+ loop1:
+ out    PORTD, r20    ; 1   +0 start of a bit pulse, both lanes
+ mov    r23, r21      ; 1   +1
+ bst    r18, 7        ; 1   +2 upper lane bit
+ bld    r23, OUTBITA  ; 1   +3
+ bst    r19, 7        ; 1   +4 lower lane bit
+ bld    r23, OUTBITB  ; 1   +5
+ out    PORTD, r23    ; 1   +6 end hi for '0' lanes (6 clocks hi)
+ lsl    r18           ; 1   +7 next bit up, MSB first
+ lsl    r19           ; 1   +8
+ nop                  ; 1   +9
+ nop                  ; 1   +10
+ nop                  ; 1   +11
+ out    PORTD, r21    ; 1   +12 end hi for '1' lanes (12 clocks hi)
+ dec    r22           ; 1   +13 how many more bits for this byte?
+ breq   bit8          ; 1/2 +14 last bit, fetch the next pair of bytes
+ nop                  ; 1   +15
+ nop                  ; 1   +16
+ nop                  ; 1   +17
+ rjmp   loop1         ; 2   +18, 20 total per bit
+ bit8:
+ ld     r18, X+       ; 2   +16 fetch next byte, upper lane
+ ld     r19, Z+       ; 2   +18 fetch next byte, lower lane
+ mul    r18, r17      ; 2   +20 scale by brightness
+ mov    r18, r1       ; 1   +22
+ add    r0, r16       ; 1   +23 dither
+ adc    r18, r14      ; 1   +24
+ add    r16, r15      ; 1   +25
+ mul    r19, r17      ; 2   +26
+ mov    r19, r1       ; 1   +28
+ add    r0, r16       ; 1   +29
+ adc    r19, r14      ; 1   +30
+ add    r16, r15      ; 1   +31
+ ldi    r22, 8        ; 1   +32 bit count for next byte
+ sbiw   r24, 1        ; 2   +33 dec byte counter (after mul, it trashes Z)
+ brne   loop1         ; 2   +35 loop back or return, 37 total for last bit
+ clr    r1            ; mul trashed the zero register
+ sub    r16, r15      ; the pair fetched past the end didn't go out
+ sub    r16, r15
+ sts    led_dither, r16 ;next transfer carries on from here
+ pop    r0
+ out    SREG, r0      ; restore global int flag
+ pop    r14
+ pop    r15
+ pop    r16
+ pop    r17
+ ret
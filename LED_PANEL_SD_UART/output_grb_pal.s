@@ -0,0 +1,185 @@
+ #define __SFR_OFFSET 0
+ #include <avr/io.h>
+
+ ;extern void output_grb_pal(u08 * idx, u16 count, u08 * palette, u08 outmask)
+ ;
+ ; Palette-indexed version of output_grb. idx holds one byte per LED, an
+ ; index into palette, which holds 3 bytes (G, R, B) per entry. count is
+ ; the number of LEDs. outmask selects the PORTD pin, ie. (1<<PIND3).
+ ;
+ ; The palette lookup for the next LED is done in the low time of the
+ ; current LED's last bit, so that bit runs a little long (36 clocks
+ ; instead of 20). That is still far below the WS2812 latch time.
+ ;
+ ; r16 = middle edge output (pushed)
+ ; r17 = bytes left in this LED (pushed)
+ ; r18 = data byte
+ ; r19 = 8-bit count
+ ; r20 = 1 output
+ ; r21 = 0 output
+ ; r22:23 = palette pointer
+ ; r24:25 = 16-bit LED count
+ ; r26:27 (X) = index pointer
+ ; r30:31 (Z) = pointer into the current palette entry
+ ; r0:r1 = mul result, r1 is cleared before returning
+
+
+ ; tools/wstiming runs this on a simulator against the WS2812B datasheet
+ ; windows, "make check" there after changing anything below.
+ ; 502 cycles per LED plus 37, so a 440 LED string takes 13.8ms at 16MHz.
+
+ .global output_grb_pal
+ output_grb_pal:
+ push   r16
+ push   r17
+ in     r0, SREG      ;save SREG (global int state)
+ push   r0
+ movw   r26, r24      ;r26:27 = X = idx
+ movw   r24, r22      ;r24:25 = count
+ movw   r22, r20      ;r22:23 = palette
+ cli                  ;no interrupts from here on, we're cycle-counting
+ in     r20, PORTD
+ or     r20, r18      ;our '1' output
+ in     r21, PORTD
+ com    r18
+ and    r21, r18      ;our '0' output
+ ldi    r19, 8        ;bit counter
+ adiw   r24, 1        ;nextled counts down first
+ rjmp   nextled       ;look up the first LED
+ loop1:
+ out    PORTD, r20    ; 1   +0 start of a bit pulse
+ mov    r16, r21      ; 1   +1 assume a '0' bit
+ sbrc   r18, 7        ; 1/2 +2
+ mov    r16, r20      ; 1   +3 '1' bit, stay high at the middle edge
+ lsl    r18           ; 1   +4 next bit up, MSB first
+ nop                  ; 1   +5
+ out    PORTD, r16    ; 1   +6 end hi for '0' bit (6 clocks hi)
+ nop                  ; 1   +7
+ nop                  ; 1   +8
+ nop                  ; 1   +9
+ nop                  ; 1   +10
+ nop                  ; 1   +11
+ out    PORTD, r21    ; 1   +12 end hi for '1' bit (12 clocks hi)
+ dec    r19           ; 1   +13 how many more bits for this byte?
+ breq   bit8          ; 1/2 +14 last bit, do differently
+ nop                  ; 1   +15
+ nop                  ; 1   +16
+ nop                  ; 1   +17
+ rjmp   loop1         ; 2   +18, 20 total per bit
+ bit8:
+ ldi    r19, 8        ; 1   +16 bit count for next byte
+ dec    r17           ; 1   +17 how many more bytes for this LED?
+ breq   nextled       ; 1/2 +18 last byte, look up the next LED
+ ld     r18, Z+       ; 2   +19 fetch next byte of this palette entry
+ rjmp   loop1         ; 2   +21, 23 total for last bit of a byte
+ nextled:
+ sbiw   r24, 1        ; 2   +20 dec LED counter
+ breq   done          ; 1/2 +22 all done?
+ ld     r18, X+       ; 2   +23 next palette index
+ ldi    r16, 3        ; 1   +25
+ mul    r18, r16      ; 2   +26 r1:r0 = index*3
+ movw   r30, r0       ; 1   +28
+ add    r30, r22      ; 1   +29
+ adc    r31, r23      ; 1   +30 Z = &palette[index*3]
+ ld     r18, Z+       ; 2   +31 G byte of the new LED
+ ldi    r17, 3        ; 1   +33 3 bytes per LED
+ rjmp   loop1         ; 2   +34, 36 total for last bit of an LED
+ done:
+ clr    r1            ;mul trashed the zero register
+ pop    r0
+ out    SREG, r0      ;restore global int flag
+ pop    r17
+ pop    r16
+ ret
+
+ ;extern void output_grb_pal4(u08 * idx, u16 count, u08 * palette, u08 outmask)
+ ;
+ ; Same with 4 bit indices, two LEDs per byte, the first one in the high
+ ; nibble, so a whole string of up to 16 colours fits in NUM_WS2812/2
+ ; bytes. count is in LEDs, with an odd count the last low nibble isn't
+ ; sent. Registers as output_grb_pal, and
+ ;
+ ; r0 = index byte of the current pair of LEDs
+ ; T = the next LED is in r0's low nibble
+ ;
+ ; The lookup makes the last bit of an LED 43 clocks instead of 36.
+ ; 509 cycles per LED plus 37, so a 440 LED string takes 14.0ms at 16MHz.
+
+ .global output_grb_pal4
+ output_grb_pal4:
+ push   r16
+ push   r17
+ in     r0, SREG      ;save SREG (global int state)
+ push   r0
+ movw   r26, r24      ;r26:27 = X = idx
+ movw   r24, r22      ;r24:25 = count
+ movw   r22, r20      ;r22:23 = palette
+ cli                  ;no interrupts from here on, we're cycle-counting
+ in     r20, PORTD
+ or     r20, r18      ;our '1' output
+ in     r21, PORTD
+ com    r18
+ and    r21, r18      ;our '0' output
+ ldi    r19, 8        ;bit counter
+ clt                  ;the first LED is in a high nibble
+ adiw   r24, 1        ;nextled4 counts down first
+ rjmp   nextled4      ;look up the first LED
+ loop4:
+ out    PORTD, r20    ; 1   +0 start of a bit pulse
+ mov    r16, r21      ; 1   +1 assume a '0' bit
+ sbrc   r18, 7        ; 1/2 +2
+ mov    r16, r20      ; 1   +3 '1' bit, stay high at the middle edge
+ lsl    r18           ; 1   +4 next bit up, MSB first
+ nop                  ; 1   +5
+ out    PORTD, r16    ; 1   +6 end hi for '0' bit (6 clocks hi)
+ nop                  ; 1   +7
+ nop                  ; 1   +8
+ nop                  ; 1   +9
+ nop                  ; 1   +10
+ nop                  ; 1   +11
+ out    PORTD, r21    ; 1   +12 end hi for '1' bit (12 clocks hi)
+ dec    r19           ; 1   +13 how many more bits for this byte?
+ breq   bit8_4        ; 1/2 +14 last bit, do differently
+ nop                  ; 1   +15
+ nop                  ; 1   +16
+ nop                  ; 1   +17
+ rjmp   loop4         ; 2   +18, 20 total per bit
+ bit8_4:
+ ldi    r19, 8        ; 1   +16 bit count for next byte
+ dec    r17           ; 1   +17 how many more bytes for this LED?
+ breq   nextled4      ; 1/2 +18 last byte, look up the next LED
+ ld     r18, Z+       ; 2   +19 fetch next byte of this palette entry
+ rjmp   loop4         ; 2   +21, 23 total for last bit of a byte
+ nextled4:
+ sbiw   r24, 1        ; 2   +20 dec LED counter
+ breq   done4         ; 1/2 +22 all done?
+ brts   lownib        ; 1/2 +23 second LED of the pair?
+ ld     r0, X+        ; 2   +24 next pair of indices
+ mov    r18, r0       ; 1   +26
+ swap   r18           ; 1   +27 high nibble first
+ set                  ; 1   +28 low nibble next time
+ rjmp   lookup4       ; 2   +29
+ lownib:
+ mov    r18, r0       ; 1   +25
+ clt                  ; 1   +26 a new pair next time
+ nop                  ; 1   +27
+ nop                  ; 1   +28
+ nop                  ; 1   +29
+ nop                  ; 1   +30 as long as the way for a high nibble
+ lookup4:
+ andi   r18, 0x0F     ; 1   +31
+ mov    r30, r18      ; 1   +32
+ lsl    r30           ; 1   +33
+ add    r30, r18      ; 1   +34 index*3
+ clr    r31           ; 1   +35
+ add    r30, r22      ; 1   +36
+ adc    r31, r23      ; 1   +37 Z = &palette[index*3]
+ ld     r18, Z+       ; 2   +38 G byte of the new LED
+ ldi    r17, 3        ; 1   +40 3 bytes per LED
+ rjmp   loop4         ; 2   +41, 43 total for last bit of an LED
+ done4:
+ pop    r0
+ out    SREG, r0      ;restore global int flag
+ pop    r17
+ pop    r16
+ ret
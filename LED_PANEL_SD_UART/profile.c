@@ -0,0 +1,64 @@
+/*
+ * profile.c
+ *
+ * See profile.h for details
+ *
+ */
+
+#include <string.h>
+#include <avr/io.h>
+#include "global.h"
+#include "profile.h"
+
+#if PROF_PRESCALE != 8
+#error "profileInit only sets up the F_CPU/8 prescaler"
+#endif
+
+profSlot profSlots[PROF_SLOTS];
+u16 profCurrent[PROF_STAGES]; // stage times of the frame being built
+
+void profileInit(void) {
+  TCCR1A = 0; // normal mode, counts 0..0xFFFF and wraps
+  TCCR1B = (1<<CS11); // F_CPU/8
+  profileReset();
+}
+
+void profileReset(void) {
+  memset(profSlots, 0, sizeof(profSlots));
+  memset(profCurrent, 0, sizeof(profCurrent));
+}
+
+void profileStop(u08 stage, u16 start) {
+  u16 t = profileStart() - start; // unsigned, so the wrap takes care of itself
+
+  // don't let a long frame wrap around to a short one
+  if (profCurrent[stage] > 0xFFFF - t) {
+    profCurrent[stage] = 0xFFFF;
+  } else {
+    profCurrent[stage] += t;
+  }
+}
+
+void profileFrame(u08 slot) {
+  profSlot *s;
+  u08 i;
+
+  if (slot < PROF_SLOTS) {
+    s = &profSlots[slot];
+    s->frames++;
+    for (i=0;i<PROF_STAGES;i++) {
+      s->last[i] = profCurrent[i];
+      if (profCurrent[i] > s->max[i]) {
+        s->max[i] = profCurrent[i];
+      }
+    }
+  }
+  memset(profCurrent, 0, sizeof(profCurrent));
+}
+
+const profSlot * profileGet(u08 slot) {
+  if (slot >= PROF_SLOTS) {
+    return NULL;
+  }
+  return &profSlots[slot];
+}
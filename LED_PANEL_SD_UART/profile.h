@@ -0,0 +1,73 @@
+/*********************************************************************
+ *
+ * Frame build profiling
+ *
+ * Timer1 runs free at F_CPU/8, so TCNT1 counts 0.5us. Each stage of
+ * a frame is timed by reading it before and after, and the times are
+ * kept per slot: one slot for each picture of the slideshow, one for
+ * each Function2 effect and one for the marquee. Times are reported in cpu cycles.
+ *
+ * A stage can be timed several times in one frame (both halves of the
+ * panel), the times add up until profileFrame() closes the frame. One
+ * stage of one frame can take up to 32ms, which is two whole strings
+ * of output.
+ *
+ * Example:
+ *   u16 t = profileStart();
+ *   fillBufferHalf(buf, picnum, 0);
+ *   profileStop(PROF_BUILD, t);
+ *   ...
+ *   profileFrame(PROF_PICTURE(picnum));
+ *
+ * The 'g' 't' command reads a slot back, see main.c.
+ *********************************************************************/
+#ifndef PROFILE_H
+#define PROFILE_H
+
+#include <avr/io.h>
+#include "global.h"
+
+#define PROF_PRESCALE       8 // Timer1 clock is F_CPU/PROF_PRESCALE
+#define PROF_CYCLES(t)      ((u32)(t)*PROF_PRESCALE)
+
+// stages of a frame
+#define PROF_BUILD          0 // filling buf: decoding, set_color, ...
+#define PROF_OUTPUT         1 // output_grb* to the LEDs
+#define PROF_STAGES         2
+
+// slots
+#define PROF_MAX_PICTURES   4
+#define PROF_PICTURE(n)     ((n)-1) // picnum 1 is slot 0
+#define PROF_EFFECT(n)      (PROF_MAX_PICTURES+(n)) // Function2 state
+#define PROF_MARQUEE        (PROF_MAX_PICTURES+7) // one column of the marquee
+#define PROF_SLOTS          (PROF_MAX_PICTURES+8)
+
+typedef struct {
+  u16 frames;               // frames profiled
+  u16 last[PROF_STAGES];    // stage times of the last frame, timer counts
+  u16 max[PROF_STAGES];     // longest seen
+} profSlot;
+
+// start Timer1, clear all slots
+void profileInit(void);
+void profileReset(void);
+
+// time stamp for profileStop()
+static inline u16 profileStart(void) {
+  u16 t;
+  // the 16 bit read goes through the TEMP register, which the
+  // scheduler's ISR uses too
+  CRITICAL_SECTION_START;
+  t = TCNT1;
+  CRITICAL_SECTION_END;
+  return t;
+}
+// add the time since start to a stage of the current frame
+void profileStop(u08 stage, u16 start);
+// the current frame is done, record it in a slot
+void profileFrame(u08 slot);
+
+// NULL for a bad slot number
+const profSlot * profileGet(u08 slot);
+
+#endif
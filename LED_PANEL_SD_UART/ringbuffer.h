@@ -0,0 +1,130 @@
+/*! \file ringbuffer.h \brief Power-of-two byte ring buffer, one producer and one consumer. */
+//*****************************************************************************
+//
+// File Name	: 'ringbuffer.h'
+// Title		: Lock-free single-producer/single-consumer byte ring buffer
+// Target MCU	: any
+// Editor Tabs	: 4
+//
+/// \par Overview
+///		Replacement for the cBuffer in bufferchris.h on the uart paths.
+///		cBuffer shares one length field between both sides, so every
+///		access needs a critical section, and it wraps its index with a
+///		16-bit % on every byte.
+///	\par
+///		Here the size must be a power of two (2..128), head and tail are
+///		free-running 8-bit counters and the index is (counter & mask).
+///		Only the producer writes head and only the consumer writes tail,
+///		so one ISR and the mainline can share a buffer with interrupts on.
+///		The fill level is (head - tail), which stays right through the
+///		8-bit wrap as long as the size is 128 or less.
+///	\par
+///		Everything is inline so the ISRs don't pay for a call.
+//
+//*****************************************************************************
+//@{
+
+#ifndef RINGBUFFER_H
+#define RINGBUFFER_H
+
+#include <avr/io.h>
+#include "global.h"
+
+//! rBuffer structure
+typedef struct struct_rBuffer
+{
+	unsigned char *dataptr;			///< the physical memory address where the buffer is stored
+	unsigned char mask;				///< size-1, size is a power of two
+	volatile unsigned char head;	///< free-running write counter, producer side only
+	volatile unsigned char tail;	///< free-running read counter, consumer side only
+} rBuffer;
+
+//! stops the compiler moving the data access past the head/tail update
+#define RBUFFER_BARRIER()	__asm__ __volatile__ ("" ::: "memory")
+
+//! initialize a buffer to start at a given address, size must be 2..128, a power of two
+static inline void rBufferInit(rBuffer* buffer, unsigned char *start, unsigned char size) {
+	buffer->dataptr = start;
+	buffer->mask = size-1;
+	buffer->head = 0;
+	buffer->tail = 0;
+}
+
+//! number of bytes in the buffer
+static inline unsigned char rBufferLength(rBuffer* buffer) {
+	return (unsigned char)(buffer->head - buffer->tail);
+}
+
+//! number of bytes that can still be added
+static inline unsigned char rBufferFree(rBuffer* buffer) {
+	return (unsigned char)(buffer->mask + 1 - rBufferLength(buffer));
+}
+
+//! TRUE if there is nothing to get
+static inline unsigned char rBufferIsEmpty(rBuffer* buffer) {
+	return (buffer->head == buffer->tail);
+}
+
+//! producer: add a byte to the end, returns TRUE, or FALSE if the buffer is full
+static inline unsigned char rBufferPut(rBuffer* buffer, unsigned char data) {
+	unsigned char head = buffer->head;
+	if ((unsigned char)(head - buffer->tail) > buffer->mask) {
+		return FALSE;
+	}
+	buffer->dataptr[head & buffer->mask] = data;
+	RBUFFER_BARRIER(); // data is in place before the consumer can see it
+	buffer->head = head + 1;
+	return TRUE;
+}
+
+//! producer: write a byte index bytes past the end without adding it yet,
+//! check rBufferFree() > index first
+static inline void rBufferPoke(rBuffer* buffer, unsigned char index, unsigned char data) {
+	buffer->dataptr[(unsigned char)(buffer->head + index) & buffer->mask] = data;
+}
+
+//! producer: add the count bytes written with rBufferPoke() to the end
+static inline void rBufferCommit(rBuffer* buffer, unsigned char count) {
+	RBUFFER_BARRIER(); // data is in place before the consumer can see it
+	buffer->head += count;
+}
+
+//! consumer: get the byte at the front, check rBufferIsEmpty() first (returns 0 if empty)
+static inline unsigned char rBufferGet(rBuffer* buffer) {
+	unsigned char tail = buffer->tail;
+	unsigned char data;
+	if (buffer->head == tail) {
+		return 0;
+	}
+	data = buffer->dataptr[tail & buffer->mask];
+	RBUFFER_BARRIER(); // data is read before the producer can reuse the slot
+	buffer->tail = tail + 1;
+	return data;
+}
+
+//! consumer: look at a byte without removing it, index 0 is the front
+static inline unsigned char rBufferPeek(rBuffer* buffer, unsigned char index) {
+	return buffer->dataptr[(unsigned char)(buffer->tail + index) & buffer->mask];
+}
+
+//! consumer: discard count bytes from the front, count <= rBufferLength()
+static inline void rBufferSkip(rBuffer* buffer, unsigned char count) {
+	buffer->tail += count;
+}
+
+//! consumer: discard everything in the buffer
+static inline void rBufferFlush(rBuffer* buffer) {
+	buffer->tail = buffer->head;
+}
+
+//! empty the buffer and start again at dataptr[0]. This touches both
+//! sides, so it runs with interrupts off.
+static inline void rBufferReset(rBuffer* buffer) {
+	CRITICAL_SECTION_START;
+	buffer->head = 0;
+	buffer->tail = 0;
+	CRITICAL_SECTION_END;
+}
+
+#endif
+//@}
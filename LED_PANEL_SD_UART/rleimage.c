@@ -0,0 +1,178 @@
+/*
+ * rleimage.c
+ *
+ * See rleimage.h for details
+ *
+ */ 
+
+#include <avr/io.h>
+#include <avr/pgmspace.h>
+#include "global.h"
+#include "rleimage.h"
+
+#define RLE_LITERAL 0x0F // run index of a literal run, with fewer than 16 colors
+
+// function prototypes, internal to library
+void rleImageLoadRun(rleCursor *);
+void rleLutBuild(rleLut *, const u08 *, u08);
+u08 rleLutColor(const rleLut *, u08, u08, u08);
+
+u08 rleImageWidth(const u08 *img) {
+  return pgm_read_byte(&img[0]);
+}
+
+u08 rleImageHeight(const u08 *img) {
+  return pgm_read_byte(&img[1]);
+}
+
+void rleImageBegin(rleCursor *c, const u08 *img) {
+  c->colors = pgm_read_byte(&img[2]);
+  c->pal = &img[3];
+  c->run = &img[3 + 3*c->colors]; // runs follow the palette
+  c->lit = NULL;
+  c->literal = (c->colors < 16) ? RLE_LITERAL : RLE_NO_INDEX;
+  c->lut = NULL;
+  c->left = 0;
+}
+
+void rleImageSetLut(rleCursor *c, rleLut *lut) {
+  c->lut = lut;
+  if (lut && (lut->pal != c->pal)) {
+    rleLutBuild(lut, c->pal, c->colors);
+  }
+}
+
+void rleLutImage(rleLut *lut, const u08 *img) {
+  if (lut->pal != &img[3]) {
+    rleLutBuild(lut, &img[3], pgm_read_byte(&img[2]));
+  }
+}
+
+void rleLutLevel(rleLut *lut, u08 level) {
+  if (level != lut->level) {
+    lut->level = level;
+    lut->pal = NULL;
+  }
+}
+
+void rleLutDither(rleLut *lut, u08 round, u08 step) {
+  if ((round != lut->round) || (step != lut->step)) {
+    lut->round = round;
+    lut->step = step;
+    lut->pal = NULL;
+  }
+}
+
+void rleImageSkip(rleCursor *c, u16 pixels) {
+  while (pixels) {
+    if (!c->left) {
+      rleImageLoadRun(c);
+    }
+    if (pixels < c->left) {
+      c->left -= pixels;
+      if (c->lit) {
+        c->lit += 3*pixels;
+      }
+      return;
+    }
+    pixels -= c->left;
+    c->left = 0;
+  }
+}
+
+const u08 * rleImageNext(rleCursor *c) {
+  u08 ch;
+
+  if (!c->left) {
+    rleImageLoadRun(c);
+  }
+  if (c->lit) {
+    for (ch=0;ch<3;ch++) {
+      c->grb[ch] = pgm_read_byte(c->lit++);
+      if (c->lut) { // not in the table, the slow way
+        c->grb[ch] = rleLutColor(c->lut, ch, c->grb[ch], 0x80);
+      }
+    }
+  }
+  c->left--;
+  return c->color;
+}
+
+u08 rleImageNextIndex(rleCursor *c) {
+  if (!c->left) {
+    rleImageLoadRun(c);
+  }
+  if (c->lit) {
+    c->lit += 3;
+  }
+  c->left--;
+  return c->index;
+}
+
+/************************************************************************
+ * rleImageLoadRun:
+ * Read the next run byte and point color at its G, R, B, in the lookup
+ * table or copied from the palette. A literal run only gets skipped
+ * over here, rleImageNext() reads its pixels.
+ ************************************************************************/
+void rleImageLoadRun(rleCursor *c) {
+  u08 run = pgm_read_byte(c->run++);
+  u08 index = run & 0x0F;
+  const u08 *entry;
+
+  c->left = (run >> 4) + 1;
+  c->lit = NULL;
+  c->index = index;
+  if (index == c->literal) {
+    c->lit = c->run;
+    c->run += 3*c->left;
+    c->color = c->grb;
+  } else if (c->lut) {
+    c->color = &c->lut->color[3*index];
+  } else {
+    entry = &c->pal[3*index];
+    c->grb[0] = pgm_read_byte(entry++);
+    c->grb[1] = pgm_read_byte(entry++);
+    c->grb[2] = pgm_read_byte(entry);
+    c->color = c->grb;
+  }
+}
+
+/************************************************************************
+ * rleLutBuild:
+ * Put the colors entries of palette pal through the gamma curve, white
+ * balance and brightness into lut's color[]. The rounding moves on by
+ * step from one entry to the next.
+ ************************************************************************/
+void rleLutBuild(rleLut *lut, const u08 *pal, u08 colors) {
+  u08 ch, i;
+  u08 round = lut->round;
+  u32 s;
+
+  for (ch=0;ch<3;ch++) {
+    s = (u32)pgm_read_byte(&lut->white[ch])*lut->level*65536/(255UL*255);
+    lut->scale[ch] = (s > 0xFFFF) ? 0xFFFF : s;
+  }
+  for (i=0;i<3*colors;i+=3) {
+    for (ch=0;ch<3;ch++) {
+      lut->color[i+ch] = rleLutColor(lut, ch, pgm_read_byte(&pal[i+ch]), round);
+    }
+    round += lut->step;
+  }
+  lut->pal = pal;
+}
+
+/************************************************************************
+ * rleLutColor:
+ * Channel ch (0 = G, 1 = R, 2 = B) of palette value v through the
+ * gamma curve, white balance and brightness, in 8.8 fixed point until
+ * round is added and it's cut to 8 bits.
+ ************************************************************************/
+u08 rleLutColor(const rleLut *lut, u08 ch, u08 v, u08 round) {
+  u16 x = ((u32)pgm_read_word(&lut->curve[v]) * lut->scale[ch]) >> 16;
+
+  if ((x >> 8) == 0xFF) { // full, and it mustn't wrap with round added
+    return 0xFF;
+  }
+  return (x + round) >> 8;
+}
@@ -0,0 +1,106 @@
+/*********************************************************************
+ *
+ * RLE16 picture decoder
+ *
+ * Pictures are made on the PC with tools/imgconv from a BMP or PPM, and
+ * included as PROGMEM headers (see ../images). The format is:
+ *
+ *   byte 0      width
+ *   byte 1      height
+ *   byte 2      number of palette entries (1-16)
+ *   palette     3 bytes per entry, G R B (LED order)
+ *   runs        one byte per run: high nibble = run length-1,
+ *               low nibble = palette index
+ *   literals    with fewer than 16 palette entries, index 15 is a literal
+ *               run: the run byte is followed by G, R, B of each pixel
+ *               (imgconv -l, for pictures that keep every color)
+ *
+ * Pixels run bottom row first, left to right. A cursor walks the runs
+ * and hands back one pixel at a time, so a picture can be streamed
+ * straight into the output buffer without unpacking it anywhere else.
+ *
+ * A cursor can put the colours through a lookup table: a 16 bit gamma
+ * curve and the white balance in pgm mem (colorlut.h, made by
+ * tools/gammalut), and the brightness. The table holds the picture's
+ * palette with all that done, 8 bits per channel, so a pixel is three
+ * byte reads from RAM. It is built again when the picture, the
+ * brightness or the rounding changes, ie. once per frame with
+ * dithering, each entry as
+ *   (curve[in] * (white[ch] * level) >> 16 + round) >> 8
+ * rounded once, at the end. round is 128, or moves like the output
+ * routines' dither threshold (see set_dither), on by step per entry.
+ * A 256 entry table per channel would be 768 bytes, more than is left
+ * next to the output buffer, and a picture never has more than 16
+ * colours. Literal pixels (imgconv -l) aren't in the palette and are
+ * worked out one by one, a 32 bit mul per byte, so the pictures that
+ * go in the firmware are made without -l.
+ *
+ * Example:
+ *   rleCursor pic;
+ *   rleLut lut = { gamma_curve, color_white }; // gamma and white balance
+ *   rleLutLevel(&lut, get_brightness());
+ *   rleLutDither(&lut, 128, 0);     // round to nearest
+ *   rleImageBegin(&pic, img_ussxmas1);
+ *   rleImageSetLut(&pic, &lut);
+ *   rleImageSkip(&pic, NUM_WS2812); // start at the second string
+ *   grb = rleImageNext(&pic);       // -> G, R, B of that pixel
+ *
+ * Or the palette indices alone, rleImageNextIndex(), with the table as
+ * the palette (rleLutImage() and lut.color), for output_grb_pal4.
+ *********************************************************************/
+#ifndef RLEIMAGE_H
+#define RLEIMAGE_H
+
+#include "global.h"
+
+typedef struct {
+  const u16 *curve; // 256 entries in pgm mem, 0-65535
+  const u08 *white; // G, R, B in pgm mem, what full white goes out as
+  const u08 *pal;   // palette color[] is for, NULL to build it again
+  u08 level;        // brightness color[] is for
+  u08 round;        // added below the last bit of entry 0
+  u08 step;         // and moved on by this each entry, 0 = round to nearest
+  u16 scale[3];     // G, R, B: white * level, 65535 = 255 * 255
+  u08 color[3*16];  // G, R, B of each palette entry, ready to go out
+} rleLut;
+
+typedef struct {
+  const u08 *pal;   // palette in pgm mem
+  const u08 *run;   // next run byte in pgm mem
+  const u08 *lit;   // next pixel of a literal run in pgm mem, NULL if not in one
+  u08 literal;      // run index of a literal run, RLE_NO_INDEX if there are none
+  u08 colors;       // palette entries
+  const rleLut *lut; // color lookup table, NULL for none
+  const u08 *color; // G, R, B of the current run
+  u08 index;        // palette index of the current run
+  u08 left;         // pixels left in the current run
+  u08 grb[3];       // color of the current run or pixel, if not in lut
+} rleCursor;
+
+#define RLE_NO_INDEX 0xFF // no run has this index
+
+// picture header accessors
+u08 rleImageWidth(const u08 *img);
+u08 rleImageHeight(const u08 *img);
+
+// brightness level for lut, the table is built again if it changed
+void rleLutLevel(rleLut *lut, u08 level);
+// where lut's rounding starts and how it moves on, per palette entry
+void rleLutDither(rleLut *lut, u08 round, u08 step);
+
+// point the cursor at the first pixel of img, no lookup table
+void rleImageBegin(rleCursor *c, const u08 *img);
+// build lut's table for img's palette, if it isn't already
+void rleLutImage(rleLut *lut, const u08 *img);
+// look colors up in lut from the next run on, NULL for none. Builds
+// the table for this picture first, if it isn't already
+void rleImageSetLut(rleCursor *c, rleLut *lut);
+// move the cursor forward, a whole run at a time where possible
+void rleImageSkip(rleCursor *c, u16 pixels);
+// return the G, R, B of the pixel at the cursor, and step past it
+const u08 * rleImageNext(rleCursor *c);
+// same, its palette index instead, for a palette indexed frame. A
+// literal pixel has none, it comes back as index 15
+u08 rleImageNextIndex(rleCursor *c);
+
+#endif
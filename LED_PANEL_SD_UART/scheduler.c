@@ -0,0 +1,92 @@
+/*
+ * scheduler.c
+ *
+ * See scheduler.h for details
+ *
+ */
+
+#include <avr/io.h>
+#include <avr/interrupt.h>
+#include "global.h"
+#include "profile.h"
+#include "scheduler.h"
+
+volatile u16 schedTicks; // ms, counted by the compare ISR
+u16 schedPeriod; // frame period in ms, 0 = stopped
+u16 schedNextFrame; // tick the next frame is due at
+u16 schedFrames;
+u16 schedOverruns;
+
+void schedInit(void) {
+  CRITICAL_SECTION_START;
+  OCR1A = TCNT1 + SCHED_TICK_COUNTS;
+  TIFR1 = (1<<OCF1A); // clear a stale match, it's cleared by writing 1
+  TIMSK1 |= (1<<OCIE1A);
+  schedTicks = 0;
+  CRITICAL_SECTION_END;
+}
+
+u16 schedMillis(void) {
+  u16 t;
+  CRITICAL_SECTION_START; // 16 bits, the ISR could change it halfway
+  t = schedTicks;
+  CRITICAL_SECTION_END;
+  return t;
+}
+
+void schedSetFramePeriod(u16 ms) {
+  schedPeriod = ms;
+  schedNextFrame = schedMillis(); // first one right away
+}
+
+u16 schedGetFramePeriod(void) {
+  return schedPeriod;
+}
+
+u08 schedFrameDue(void) {
+  u16 late;
+
+  if (schedPeriod == 0) {
+    return FALSE;
+  }
+  late = schedMillis() - schedNextFrame;
+  if (late >= 0x8000) { // "negative", not due yet
+    return FALSE;
+  }
+  schedFrames++;
+  if (late >= schedPeriod) { // missed a whole frame, start again from now
+    schedOverruns++;
+    schedNextFrame += late;
+  }
+  schedNextFrame += schedPeriod;
+  return TRUE;
+}
+
+u16 schedGetFrames(void) {
+  return schedFrames;
+}
+
+u16 schedGetOverruns(void) {
+  return schedOverruns;
+}
+
+/*********************************************************************
+ * 1ms tick. With interrupts off for a while several ms can go by
+ * before we get here. The whole ms are counted from how far the timer
+ * is past the match, which holds for anything short of a Timer1 wrap
+ * (32ms). Then the next match goes ahead of the timer again, one more
+ * if it got past that one meanwhile.
+ *********************************************************************/
+ISR(TIMER1_COMPA_vect) {
+  u16 late = TCNT1 - OCR1A; // counts since the match we're here for
+
+  while (late >= SCHED_TICK_COUNTS) {
+    OCR1A += SCHED_TICK_COUNTS;
+    schedTicks++;
+    late -= SCHED_TICK_COUNTS;
+  }
+  do {
+    OCR1A += SCHED_TICK_COUNTS;
+    schedTicks++;
+  } while ((s16)(TCNT1 - OCR1A) >= 0);
+}
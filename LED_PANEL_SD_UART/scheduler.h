@@ -0,0 +1,52 @@
+/*********************************************************************
+ *
+ * Frame scheduler
+ *
+ * A 1ms tick from Timer1 compare A. Timer1 keeps running free for the
+ * profile (profile.h), the compare register is moved on 1ms at a time.
+ * The output goes in chunks (set_output_chunk(), well under 1ms with
+ * interrupts off), the tick catches up on any ms it missed when they
+ * are back on. That works for up to a Timer1 wrap, 32ms, anything
+ * longer loses ticks.
+ *
+ * Frames are released at a fixed period, counted from when they were
+ * due and not from when the last one was done, so the frame rate does
+ * not depend on how long a frame takes to build. A frame that is a
+ * whole period or more late counts as an overrun, and the schedule
+ * starts again from now instead of rushing out the missed frames.
+ *
+ * Example:
+ *   profileInit(); // starts Timer1
+ *   schedInit();
+ *   schedSetFramePeriod(40); // 25 frames/s
+ *   sei();
+ *   while (1) {
+ *     if (schedFrameDue()) {
+ *       ... build and output a frame ...
+ *     }
+ *     ... anything else, e.g. commands ...
+ *   }
+ *********************************************************************/
+#ifndef SCHEDULER_H
+#define SCHEDULER_H
+
+#include "global.h"
+#include "profile.h"
+
+#define SCHED_TICK_COUNTS   (F_CPU/PROF_PRESCALE/1000) // Timer1 counts per ms
+
+// start the tick, Timer1 has to be running (profileInit)
+void schedInit(void);
+// ms since schedInit, wraps every 65.5s. Compare with (u16)(a - b)
+u16 schedMillis(void);
+
+// 0 stops releasing frames
+void schedSetFramePeriod(u16 ms);
+u16 schedGetFramePeriod(void);
+// TRUE once each frame period
+u08 schedFrameDue(void);
+// frames released, and frames that were a whole period late
+u16 schedGetFrames(void);
+u16 schedGetOverruns(void);
+
+#endif
@@ -31,9 +31,12 @@ volatile u08   uartBufferedTx;		///< uartBufferedTx flag
 volatile u08   uartTxIntData;
 volatile u08   uartRxIntData;
 // receive and transmit buffers
-cBuffer uartRxBuffer;				///< uart receive buffer
-cBuffer uartTxBuffer;				///< uart transmit buffer
+rBuffer uartRxBuffer;				///< uart receive buffer, rx ISR -> mainline
+rBuffer uartTxBuffer;				///< uart transmit buffer, mainline -> tx ISR
 unsigned short uartRxOverflow;		///< receive overflow counter
+unsigned short uartRxFrameErrors;	///< receive framing error counter
+unsigned short uartRxOverruns;		///< receive data overrun counter
+static u32 uartBaudRate;			///< rate from the last uartSetBaudRate()
 
 #ifndef UART_BUFFERS_EXTERNAL_RAM
 	// using internal ram,
@@ -45,6 +48,10 @@ unsigned short uartRxOverflow;		///< receive overflow counter
 typedef void (*voidFuncPtru08)(unsigned char);
 volatile static voidFuncPtru08 UartRxFunc;
 
+#ifdef UART_TX_UDRE
+static void uartStartTx(void);
+#endif
+
 // enable and initialize the uart
 void uartInit(void) {
 	// clear interrupts for the duration of set up (in case they were enabled before)
@@ -55,7 +62,7 @@ void uartInit(void) {
 	UartRxFunc = 0;
 
 	// enable RxD/TxD and interrupts
-	// (added UDRIE0 for data reg empty interrupt for TX optional|BV(UDRIE))
+	// (with UART_TX_UDRE, UDRIE gets turned on while there is data to send)
 	outb(UCSRB, BV(TXCIE)|BV(RXCIE)|BV(RXEN)|BV(TXEN));
 	
 	// set default baud rate
@@ -63,8 +70,10 @@ void uartInit(void) {
 	// initialize states
 	uartReadyTx = TRUE;
 	uartBufferedTx = FALSE;
-	// clear overflow count
+	// clear overflow and error counts
 	uartRxOverflow = 0;
+	uartRxFrameErrors = 0;
+	uartRxOverruns = 0;
   // if we are using RS485 standard, set outputs to Hi-Z
   #ifdef UART_USE_RS485
   uart485OutputDisable();
@@ -79,14 +88,14 @@ void uartInitBuffers(void)
 {
 	#ifndef UART_BUFFERS_EXTERNAL_RAM
 		// initialize the UART receive buffer
-		bufferInit(&uartRxBuffer, uartRxData, UART_RX_BUFFER_SIZE);
+		rBufferInit(&uartRxBuffer, uartRxData, UART_RX_BUFFER_SIZE);
 		// initialize the UART transmit buffer
-		bufferInit(&uartTxBuffer, uartTxData, UART_TX_BUFFER_SIZE);
+		rBufferInit(&uartTxBuffer, uartTxData, UART_TX_BUFFER_SIZE);
 	#else
 		// initialize the UART receive buffer
-		bufferInit(&uartRxBuffer, (u08*) UART_RX_BUFFER_ADDR, UART_RX_BUFFER_SIZE);
+		rBufferInit(&uartRxBuffer, (u08*) UART_RX_BUFFER_ADDR, UART_RX_BUFFER_SIZE);
 		// initialize the UART transmit buffer
-		bufferInit(&uartTxBuffer, (u08*) UART_TX_BUFFER_ADDR, UART_TX_BUFFER_SIZE);
+		rBufferInit(&uartTxBuffer, (u08*) UART_TX_BUFFER_ADDR, UART_TX_BUFFER_SIZE);
 	#endif
 }
 
@@ -97,29 +106,101 @@ void uartSetRxHandler(void (*rx_func)(unsigned char c))
 	UartRxFunc = rx_func;
 }
 
+// work out the division factor for baudrate, in normal or double speed
+// mode, whichever gets closer. Returns the rate error in tenths of a percent.
+// A divisor over UART_UBRR_MAX doesn't fit UBRR, the caller has to check.
+static u16 uartBaudDivisor(u32 baudrate, u16 *bauddiv, u08 *u2x)
+{
+	u32 actual, actual2x, err, err2x;
+	u32 div, div2x;
+	// normal mode samples each bit 16 times, double speed mode 8 times
+	div = ((F_CPU+(baudrate*8L))/(baudrate*16L)-1);
+	div2x = ((F_CPU+(baudrate*4L))/(baudrate*8L)-1);
+	actual = F_CPU/(16L*(div+1));
+	actual2x = F_CPU/(8L*(div2x+1));
+	err = (actual > baudrate) ? actual-baudrate : baudrate-actual;
+	err2x = (actual2x > baudrate) ? actual2x-baudrate : baudrate-actual2x;
+	// normal mode is more tolerant of clock mismatch, only give it up
+	// if double speed is actually closer, and only if its divisor fits
+	// (below ~490 baud at 16MHz it doesn't)
+	*u2x = (err2x < err) && (div2x <= UART_UBRR_MAX);
+	if (*u2x) {
+		div = div2x;
+		err = err2x;
+	}
+	*bauddiv = (div > 0xFFFF) ? 0xFFFF : div;
+	return (err*1000L)/baudrate;
+}
+
 // set the uart baud rate
 void uartSetBaudRate(u32 baudrate)
 {
+	u16 bauddiv;
+	u08 u2x;
 	// calculate division factor for requested baud rate, and set it
-	u16 bauddiv = ((F_CPU+(baudrate*8L))/(baudrate*16L)-1);
+	uartBaudDivisor(baudrate, &bauddiv, &u2x);
+	if (u2x) {
+		sbi(UCSRA, U2X);
+	} else {
+		cbi(UCSRA, U2X);
+	}
 	outb(UBRRL, bauddiv);
 	#ifdef UBRRH
 	outb(UBRRH, bauddiv>>8);
 	#endif
+	uartBaudRate = baudrate;
+}
+
+// returns the current baud rate
+u32 uartGetBaudRate(void)
+{
+	return uartBaudRate;
+}
+
+// check that a baud rate can be made closely enough
+u08 uartCheckBaudRate(u32 baudrate)
+{
+	u16 bauddiv;
+	u08 u2x;
+	if ((baudrate < 300) || (baudrate > F_CPU/8)) {
+		return FALSE;
+	}
+	if (uartBaudDivisor(baudrate, &bauddiv, &u2x) > UART_BAUD_TOLERANCE) {
+		return FALSE;
+	}
+	if (bauddiv > UART_UBRR_MAX) {
+		return FALSE;
+	}
+	return TRUE;
+}
+
+// wait for the transmitter to finish the last byte
+void uartWaitTxDone(void)
+{
+	// uartReadyTx is set by the tx complete interrupt, so the stop bit is out
+	while(!uartReadyTx);
 }
 
 // returns the receive buffer structure 
-cBuffer* uartGetRxBuffer(void) {
+rBuffer* uartGetRxBuffer(void) {
 	// return rx buffer pointer
 	return &uartRxBuffer;
 }
 
 // returns the transmit buffer structure 
-cBuffer* uartGetTxBuffer(void) {
+rBuffer* uartGetTxBuffer(void) {
 	// return tx buffer pointer
 	return &uartTxBuffer;
 }
 
+#ifdef UART_TX_UDRE
+// queues a byte for the uart, waits only if the tx buffer is full
+void uartSendByte(u08 txData) {
+	while(!rBufferPut(&uartTxBuffer, txData));
+	uartStartTx();
+}
+#else
+
 // transmits a byte over the uart
 void uartSendByte(u08 txData) {
 	// wait for the transmitter to be ready
@@ -132,6 +213,7 @@ void uartSendByte(u08 txData) {
 	// set ready state to FALSE
 	uartReadyTx = FALSE;
 }
+#endif
 
 // gets a single byte from the uart receive buffer (getchar-style)
 int uartGetByte(void) {
@@ -144,25 +226,16 @@ int uartGetByte(void) {
 
 // gets a byte (if available) from the uart receive buffer
 u08 uartReceiveByte(u08* rxData) {
-	// make sure we have a receive buffer
-	if(uartRxBuffer.size)
+	// make sure we have data
+	if(!rBufferIsEmpty(&uartRxBuffer))
 	{
-		// make sure we have data
-		if(uartRxBuffer.datalength)
-		{
-			// get byte from beginning of buffer
-			*rxData = bufferGetFromFront(&uartRxBuffer);
-			return TRUE;
-		}
-		else
-		{
-			// no data
-			return FALSE;
-		}
+		// get byte from beginning of buffer
+		*rxData = rBufferGet(&uartRxBuffer);
+		return TRUE;
 	}
 	else
 	{
-		// no buffer
+		// no data
 		return FALSE;
 	}
 }
@@ -171,14 +244,12 @@ u08 uartReceiveByte(u08* rxData) {
 void uartFlushReceiveBuffer(void)
 {
 	// flush all data from receive buffer
-	//bufferFlush(&uartRxBuffer);
-	// same effect as above
-	uartRxBuffer.datalength = 0;
+	rBufferFlush(&uartRxBuffer);
 }
 
 // return true if uart receive buffer is empty
 u08 uartReceiveBufferIsEmpty(void) {
-	if(uartRxBuffer.datalength == 0)
+	if(rBufferIsEmpty(&uartRxBuffer))
 	{
 		return TRUE;
 	}
@@ -191,9 +262,53 @@ u08 uartReceiveBufferIsEmpty(void) {
 // add byte to end of uart Tx buffer
 u08 uartAddToTxBuffer(u08 data) {
 	// add data byte to the end of the tx buffer
-	return bufferAddToEnd(&uartTxBuffer, data);
+	return rBufferPut(&uartTxBuffer, data);
 }
 
+#ifdef UART_TX_UDRE
+// start transmission of the current uart Tx buffer contents
+void uartSendTxBuffer(void) {
+	if(!rBufferIsEmpty(&uartTxBuffer))
+	{
+		uartStartTx();
+	}
+}
+
+// queue nBytes from buffer for the uart. Does not wait for the
+// transmitter, only for room in the tx buffer if an earlier message
+// is still going out.
+u08 uartSendBuffer(char *buffer, u16 nBytes) {
+	register u16 i;
+	
+	// check that it can ever fit (and that we have any bytes to send at all)
+	if((nBytes > (u16)uartTxBuffer.mask+1) || !nBytes)
+	{
+		// return failure
+		return FALSE;
+	}
+	// wait for the tx ISR to make room
+	while(rBufferFree(&uartTxBuffer) < nBytes);
+	for(i = 0; i < nBytes; i++)
+	{
+		// put data bytes at end of buffer
+		rBufferPut(&uartTxBuffer, *buffer++);
+	}
+	uartStartTx();
+	// return success
+	return TRUE;
+}
+
+// get the UDRE interrupt feeding the uart
+static void uartStartTx(void) {
+	// TXC can't report idle until UDR is written, so this is safe
+	uartReadyTx = FALSE;
+  #ifdef UART_USE_RS485
+  uart485OutputEnable();
+  #endif
+	sbi(UCSRB, UDRIE);
+}
+#else
+
 // start transmission of the current uart Tx buffer contents
 void uartSendTxBuffer(void) {
 	
@@ -208,7 +323,7 @@ void uartSendTxBuffer(void) {
   #ifdef UART_USE_RS485
   uart485OutputEnable();
   #endif
-	uartSendByte(bufferGetFromFront(&uartTxBuffer));
+	uartSendByte(rBufferGet(&uartTxBuffer));
 }
 
 // transmit nBytes from buffer out the uart
@@ -222,7 +337,7 @@ u08 uartSendBuffer(char *buffer, u16 nBytes) {
 	
 	
 	// check if there's space (and that we have any bytes to send at all)
-	if((uartTxBuffer.datalength + nBytes < uartTxBuffer.size) && nBytes)
+	if((nBytes <= rBufferFree(&uartTxBuffer)) && nBytes)
 	{
 		// grab first character
 		first = *buffer++;
@@ -230,7 +345,7 @@ u08 uartSendBuffer(char *buffer, u16 nBytes) {
 		for(i = 0; i < nBytes-1; i++)
 		{
 			// put data bytes at end of buffer
-			bufferAddToEnd(&uartTxBuffer, *buffer++);
+			rBufferPut(&uartTxBuffer, *buffer++);
 		}
 
 		// send the first byte to get things going by interrupts
@@ -251,6 +366,8 @@ u08 uartSendBuffer(char *buffer, u16 nBytes) {
 	}
 }
 
+#endif
+
 #ifdef UART_USE_RS485
 inline void uart485OutputEnable(void) {
   UARTRS485PORT |= BV(RS485PIN);
@@ -263,6 +380,37 @@ inline void uart485EnableDriverCntlPin(void) {
   UARTRS485DDR |= BV(RS485PIN);
 }
 #endif
+
+#ifdef UART_TX_UDRE
+// UART Data Register Empty Interrupt Handler
+// UDR has room for the next byte while the current one is shifted out,
+// so the line never goes idle between bytes.
+UART_INTERRUPT_HANDLER(SIG_UART_DATA) {
+	if(!rBufferIsEmpty(&uartTxBuffer))
+	{
+		outb(UDR0, rBufferGet(&uartTxBuffer));
+	}
+	else
+	{
+		// nothing left, TXC will tell us when the last byte is out
+		cbi(UCSRB, UDRIE);
+	}
+}
+
+// UART Transmit Complete Interrupt Handler
+// Only marks the end of a message: back to ready, release the RS485 line.
+UART_INTERRUPT_HANDLER(SIG_UART_TRANS) {
+	// if more got queued the UDRE interrupt is running again, not idle yet
+	if(rBufferIsEmpty(&uartTxBuffer) && !(inb(UCSRB) & BV(UDRIE)))
+	{
+		uartReadyTx = TRUE;
+    #ifdef UART_USE_RS485
+    uart485OutputDisable();
+    #endif
+	}
+}
+#else
+
 // UART Data Register Empty Interrupt Handler
 UART_INTERRUPT_HANDLER(SIG_UART_DATA) {
   // nop
@@ -276,25 +424,10 @@ UART_INTERRUPT_HANDLER(SIG_UART_TRANS) {
 	{
 		
 		// check if there's data left in the buffer
-		if(uartTxBuffer.datalength)
+		if(!rBufferIsEmpty(&uartTxBuffer))
 		{
 			// send byte from top of buffer
-      /* The Following section is expanded from bufferGetFromFront() */
-			//uartTxIntData = bufferGetFromFront(&uartTxBuffer);
-      uartTxIntData = 0;
-			if(uartTxBuffer.datalength)
-			{
-				// get the first character from buffer
-				uartTxIntData = uartTxBuffer.dataptr[uartTxBuffer.dataindex];
-				// move index down and decrement length
-				uartTxBuffer.dataindex++;
-				if(uartTxBuffer.dataindex >= uartTxBuffer.size)
-				{
-					uartTxBuffer.dataindex -= uartTxBuffer.size;
-				}
-				uartTxBuffer.datalength--;
-			}
-			outb(UDR0, uartTxIntData);
+			outb(UDR0, rBufferGet(&uartTxBuffer));
 		}
 		else
 		{
@@ -317,11 +450,19 @@ UART_INTERRUPT_HANDLER(SIG_UART_TRANS) {
     #endif
 	}
 }
+#endif
 
 // UART Receive Complete Interrupt Handler
 UART_INTERRUPT_HANDLER(SIG_UART_RECV)
 {
 	u08 c;
+	// count line errors, the flags are only valid before UDR is read
+	if (UCSRA & BV(FE)) {
+		uartRxFrameErrors++;
+	}
+	if (UCSRA & BV(DOR)) {
+		uartRxOverruns++;
+	}
 	// get received char
 	c = inb(UDR);
   
@@ -338,7 +479,7 @@ UART_INTERRUPT_HANDLER(SIG_UART_RECV)
 		// otherwise do default processing
 		// put received char in buffer
 		// check if there's space
-		if( !bufferAddToEnd(&uartRxBuffer, c) )
+		if( !rBufferPut(&uartRxBuffer, c) )
 		{
 			// no space in buffer
 			// count overflow
@@ -3,7 +3,7 @@
 //
 // This UART library has been debugged and modified to work properly, using
 // the Pascal Stang lib as a base. Note that to use this library, you also
-// need bufferchris.h and .c, as well as global.h to define clock speed.
+// need ringbuffer.h, as well as global.h to define clock speed.
 // The primary addition is for the uart buffered send routines to wait until 
 // ready for TX flag is true, before enabling buffered mode. This prevents 
 // the ISR from the last send to erroneously send the next string before the 
@@ -67,12 +67,25 @@
 #ifndef UART_H
 #define UART_H
 
-#include "bufferchris.h"
+#include "ringbuffer.h"
 
 //! Default uart baud rate.
 /// This is the default speed after a uartInit() command,
 /// and can be changed by using uartSetBaudRate().
+/// Override it in global.h. At 16MHz, 250000, 500000, 1000000 and 2000000
+/// are exact; 2000000 needs double speed (U2X) mode, which
+/// uartSetBaudRate() picks by itself.
+#ifndef UART_DEFAULT_BAUD_RATE
 #define UART_DEFAULT_BAUD_RATE	19200
+#endif
+
+//! Largest baud rate error uartCheckBaudRate() accepts, in tenths of a percent.
+#ifndef UART_BAUD_TOLERANCE
+#define UART_BAUD_TOLERANCE		20
+#endif
+
+//! Largest divisor UBRR holds (12 bits).
+#define UART_UBRR_MAX			4095
 
 // buffer memory allocation defines
 // buffer sizes
@@ -89,6 +102,14 @@
 #define UART_RX_BUFFER_SIZE		0x0040
 #endif
 
+// the buffers are rBuffers, see ringbuffer.h
+#if (UART_TX_BUFFER_SIZE & (UART_TX_BUFFER_SIZE-1)) || (UART_TX_BUFFER_SIZE > 128)
+#error UART_TX_BUFFER_SIZE must be a power of two, 128 or less
+#endif
+#if (UART_RX_BUFFER_SIZE & (UART_RX_BUFFER_SIZE-1)) || (UART_RX_BUFFER_SIZE > 128)
+#error UART_RX_BUFFER_SIZE must be a power of two, 128 or less
+#endif
+
 // define this key if you wish to use
 // external RAM for the	UART buffers
 //#define UART_BUFFER_EXTERNAL_RAM
@@ -102,6 +123,14 @@
 // multiple slave with output disabling
 //#define UART_USE_RS485
 
+// define this key to feed the transmitter from the data register empty
+// (UDRE) interrupt. The next byte waits in UDR while the current one is
+// shifted out, so there are no gaps between bytes, and uartSendBuffer()
+// only waits for buffer room, never for the transmitter. TXC is then only
+// used to mark the end of a message (uartReadyTx, RS485 release).
+// Comment it out to go back to sending one byte per TXC interrupt.
+#define UART_TX_UDRE
+
 #ifdef UART_USE_RS485
   #define UARTRS485PORT PORTD
   #define UARTRS485DDR DDRD
@@ -138,6 +167,9 @@
 	#define TXEN				TXEN0
 	#define UBRRL				UBRR0L
 	#define UBRRH				UBRR0H
+	#define U2X					U2X0
+	#define FE					FE0
+	#define DOR					DOR0
 #endif
 #if	defined(__AVR_ATmega328P__)
 	#define SIG_UART_TRANS	USART_TX_vect
@@ -168,15 +200,28 @@ void uartSetRxHandler(void (*rx_func)(unsigned char c));
 
 //! Sets the uart baud rate.
 /// Argument should be in bits-per-second, like \c uartSetBaudRate(9600);
+/// Double speed (U2X) mode is used when it gets closer to the rate.
 void uartSetBaudRate(u32 baudrate);
 
+//! Returns the baud rate last passed to uartSetBaudRate().
+///
+u32 uartGetBaudRate(void);
+
+//! Returns TRUE if baudrate can be made within UART_BAUD_TOLERANCE,
+/// with a divisor that fits UBRR.
+u08 uartCheckBaudRate(u32 baudrate);
+
+//! Waits until the last byte queued for transmit has left the uart.
+/// Call this before changing the baud rate.
+void uartWaitTxDone(void);
+
 //! Returns pointer to the receive buffer structure.
 ///
-cBuffer* uartGetRxBuffer(void);
+rBuffer* uartGetRxBuffer(void);
 
 //! Returns pointer to the transmit buffer structure.
 ///
-cBuffer* uartGetTxBuffer(void);
+rBuffer* uartGetTxBuffer(void);
 
 //! Sends a single byte over the uart.
 /// \note This function waits for the uart to be ready,
@@ -218,6 +263,8 @@ void uartSendTxBuffer(void);
 //! Sends a block of data via the uart using interrupt control.
 /// \param buffer	pointer to data to be sent
 ///	\param nBytes	length of data (number of bytes to sent)
+/// With UART_TX_UDRE this returns as soon as the data is queued, it only
+/// waits if an earlier message still holds the room it needs.
 u08  uartSendBuffer(char *buffer, u16 nBytes);
 
 #ifdef UART_USE_RS485
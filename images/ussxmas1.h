@@ -0,0 +1,27 @@
+// Generated by imgconv from ussxmas1.bmp, do not edit.
+// 40x22, 16 colors, 348 bytes (2640 raw)
+
+const uint8_t img_ussxmas1[] PROGMEM = {
+	0x28, 0x16, 0x10, 0x9c, 0x0c, 0x09, 0x04, 0xff, 0x04, 0xc6, 0xff, 0x00, 0xa5, 0xff, 0xa3, 0x96,
+	0x00, 0xe8, 0xc5, 0x02, 0x00, 0xff, 0x92, 0x90, 0x5a, 0xff, 0x58, 0x44, 0x75, 0x11, 0xe5, 0xff,
+	0xe1, 0xe3, 0xbb, 0xf6, 0xfe, 0x4f, 0x00, 0xbb, 0x58, 0x54, 0xfe, 0xf4, 0x00, 0xf7, 0x03, 0x03,
+	0xfe, 0x5b, 0x59, 0xf9, 0x59, 0x13, 0xf9, 0x99, 0x43, 0x79, 0x13, 0x19, 0x03, 0x09, 0x03, 0x17,
+	0x43, 0x49, 0x03, 0x07, 0x11, 0x07, 0x13, 0xf9, 0x43, 0x01, 0x28, 0x61, 0x07, 0x03, 0x29, 0x03,
+	0x17, 0x01, 0x13, 0x11, 0x27, 0x03, 0x17, 0x21, 0x07, 0x09, 0x51, 0x28, 0x21, 0x07, 0x09, 0x91,
+	0x17, 0x31, 0x07, 0x03, 0x21, 0x07, 0x09, 0x81, 0x28, 0x31, 0x07, 0xb1, 0x03, 0x07, 0x11, 0x07,
+	0x13, 0x81, 0x3e, 0x05, 0x18, 0x81, 0x07, 0x03, 0x51, 0x09, 0x03, 0x01, 0x17, 0x09, 0x03, 0x91,
+	0x1e, 0x35, 0x00, 0x05, 0xc1, 0x09, 0x11, 0x07, 0x11, 0x17, 0xa1, 0x1e, 0x0f, 0x0e, 0x05, 0x10,
+	0x25, 0x81, 0x07, 0x01, 0x03, 0x61, 0x07, 0xa1, 0x0e, 0x0f, 0x0e, 0x05, 0x0e, 0x25, 0x41, 0x34,
+	0x01, 0x07, 0x21, 0x14, 0x11, 0x27, 0x44, 0x21, 0x04, 0x11, 0x4e, 0x0c, 0x31, 0x07, 0x11, 0x44,
+	0x21, 0x44, 0x07, 0x01, 0x64, 0x01, 0x24, 0x5e, 0x10, 0x0e, 0x11, 0x03, 0x11, 0x04, 0x11, 0x14,
+	0x51, 0x14, 0x51, 0x24, 0x11, 0x04, 0x01, 0x1e, 0x06, 0x4e, 0x41, 0x14, 0x21, 0x04, 0x11, 0x09,
+	0x03, 0x21, 0x14, 0x51, 0x14, 0x41, 0x0e, 0x0f, 0x3e, 0x51, 0x14, 0x21, 0x14, 0x01, 0x03, 0x07,
+	0x11, 0x24, 0x31, 0x24, 0x21, 0x04, 0x21, 0x2e, 0x0c, 0x61, 0x14, 0x21, 0x14, 0x21, 0x34, 0x31,
+	0x24, 0x31, 0x04, 0x11, 0x3e, 0x00, 0x0e, 0x51, 0x14, 0x21, 0x14, 0x11, 0x14, 0x51, 0x24, 0x31,
+	0x24, 0x01, 0x1e, 0x0f, 0x1e, 0x21, 0x13, 0x11, 0x14, 0x21, 0x14, 0x11, 0x14, 0x51, 0x24, 0x31,
+	0x24, 0x11, 0x0e, 0x06, 0x1e, 0x61, 0x14, 0x11, 0x14, 0x21, 0x54, 0x01, 0x03, 0x0a, 0x44, 0x01,
+	0x24, 0x11, 0x0b, 0x0d, 0x0b, 0x71, 0x04, 0x31, 0x07, 0x31, 0x34, 0x31, 0x24, 0x31, 0x04, 0x21,
+	0x02, 0x0d, 0x02, 0x41, 0x07, 0x61, 0x03, 0x07, 0xf1, 0x31, 0x03, 0x11, 0x02, 0x11, 0x03, 0x07,
+	0x01, 0x07, 0x09, 0x01, 0x07, 0x03, 0xf1, 0x31, 0x03, 0x07, 0x31, 0x09, 0x11, 0x03, 0x07, 0x01,
+	0x17, 0x31, 0x17, 0xa1, 0x03, 0x09, 0x61, 0x09, 0x03, 0x61, 0x17, 0x61,
+};
@@ -0,0 +1,30 @@
+// Generated by imgconv from ussxmas2.bmp, do not edit.
+// 40x22, 16 colors, 395 bytes (2640 raw)
+
+const uint8_t img_ussxmas2[] PROGMEM = {
+	0x28, 0x16, 0x10, 0x9c, 0x0e, 0x0b, 0x07, 0xff, 0x06, 0x81, 0xff, 0x7f, 0xaa, 0xff, 0xa8, 0x96,
+	0x01, 0xe8, 0xee, 0x05, 0x04, 0xff, 0x8f, 0x00, 0x4b, 0xfe, 0x49, 0xe6, 0xfe, 0xe2, 0xff, 0xa8,
+	0xa8, 0xff, 0x77, 0x77, 0xe7, 0xff, 0x03, 0x44, 0x75, 0x11, 0xc3, 0xff, 0xc0, 0xe1, 0x5b, 0x59,
+	0x68, 0xff, 0x67, 0xc8, 0x2d, 0x48, 0x3d, 0xf8, 0x88, 0x2d, 0x03, 0x1d, 0x58, 0x1d, 0x03, 0x18,
+	0x0d, 0x08, 0x03, 0x07, 0x0f, 0x13, 0x02, 0x03, 0x0d, 0x18, 0x0d, 0x18, 0x03, 0x07, 0x11, 0x07,
+	0x02, 0x03, 0xf8, 0x0d, 0x13, 0x0d, 0x03, 0x01, 0x2c, 0x21, 0x0d, 0x08, 0x11, 0x07, 0x0d, 0x08,
+	0x0d, 0x08, 0x0d, 0x02, 0x07, 0x18, 0x03, 0x11, 0x02, 0x08, 0x02, 0x03, 0x17, 0x0d, 0x08, 0x17,
+	0x08, 0x51, 0x2c, 0x21, 0x07, 0x08, 0x31, 0x08, 0x0d, 0x31, 0x08, 0x0d, 0x21, 0x02, 0x18, 0x0f,
+	0x11, 0x07, 0x08, 0x81, 0x2c, 0x31, 0x07, 0x31, 0x07, 0x08, 0x11, 0x08, 0x01, 0x27, 0x21, 0x07,
+	0x02, 0x0f, 0x81, 0x35, 0x00, 0x1c, 0x81, 0x07, 0x03, 0x11, 0x0f, 0x01, 0x07, 0xe1, 0x0f, 0x11,
+	0x45, 0x10, 0x05, 0x21, 0x07, 0x81, 0x08, 0x11, 0x07, 0x11, 0x07, 0x81, 0x03, 0x0f, 0x01, 0x15,
+	0x0a, 0x15, 0x00, 0x0e, 0x20, 0x01, 0x03, 0x81, 0x02, 0x61, 0x07, 0x71, 0x07, 0x11, 0x05, 0x0e,
+	0x25, 0x0e, 0x00, 0x05, 0x11, 0x02, 0x11, 0x34, 0x21, 0x0f, 0x01, 0x14, 0x11, 0x17, 0x0f, 0x44,
+	0x21, 0x04, 0x11, 0x45, 0x0e, 0x61, 0x44, 0x11, 0x03, 0x44, 0x07, 0x01, 0x64, 0x01, 0x24, 0x15,
+	0x0a, 0x09, 0x15, 0x10, 0x05, 0x41, 0x04, 0x11, 0x14, 0x11, 0x07, 0x21, 0x14, 0x51, 0x24, 0x11,
+	0x04, 0x01, 0x15, 0x09, 0x0a, 0x35, 0x41, 0x14, 0x21, 0x04, 0x61, 0x14, 0x51, 0x14, 0x41, 0x05,
+	0x0e, 0x35, 0x51, 0x14, 0x21, 0x14, 0x01, 0x17, 0x11, 0x24, 0x01, 0x0f, 0x11, 0x24, 0x21, 0x04,
+	0x21, 0x25, 0x0e, 0x21, 0x08, 0x21, 0x14, 0x21, 0x14, 0x21, 0x34, 0x11, 0x02, 0x08, 0x24, 0x31,
+	0x04, 0x11, 0x35, 0x00, 0x05, 0x51, 0x14, 0x21, 0x14, 0x11, 0x14, 0x01, 0x08, 0x0d, 0x21, 0x24,
+	0x31, 0x24, 0x01, 0x15, 0x08, 0x15, 0x21, 0x0f, 0x02, 0x11, 0x14, 0x21, 0x14, 0x11, 0x14, 0x51,
+	0x24, 0x31, 0x24, 0x11, 0x05, 0x09, 0x15, 0x51, 0x02, 0x14, 0x11, 0x14, 0x21, 0x54, 0x11, 0x07,
+	0x44, 0x01, 0x24, 0x0f, 0x01, 0x06, 0x0b, 0x06, 0x01, 0x08, 0x07, 0x31, 0x0d, 0x04, 0x81, 0x34,
+	0x31, 0x24, 0x02, 0x21, 0x04, 0x01, 0x03, 0x01, 0x2b, 0x41, 0x07, 0x01, 0x0f, 0xb1, 0x0d, 0x08,
+	0x61, 0x1d, 0x31, 0x07, 0x01, 0x07, 0x0b, 0xc1, 0x07, 0xf1, 0x01, 0x0f, 0xf1, 0x31, 0x03, 0x0d,
+	0x02, 0xa1, 0x08, 0x0d, 0x21, 0x0f, 0x71, 0x02, 0x0d, 0x07, 0x41,
+};
@@ -0,0 +1,28 @@
+// Generated by imgconv from ussxmas3.bmp, do not edit.
+// 40x22, 16 colors, 357 bytes (2640 raw)
+
+const uint8_t img_ussxmas3[] PROGMEM = {
+	0x28, 0x16, 0x10, 0x9c, 0x0e, 0x0b, 0x09, 0xff, 0x09, 0x93, 0xff, 0x1e, 0xa8, 0xff, 0xa7, 0x96,
+	0x03, 0xe7, 0xc6, 0x09, 0x08, 0xff, 0xa8, 0xa8, 0x5a, 0xff, 0x5a, 0xff, 0x77, 0x77, 0x44, 0x75,
+	0x11, 0xe3, 0xfe, 0xe0, 0xe2, 0x5b, 0x59, 0xff, 0x9f, 0x00, 0xe3, 0xbb, 0xf6, 0xf9, 0xfc, 0x04,
+	0xf7, 0x04, 0x04, 0xfa, 0x5a, 0x13, 0xfa, 0x9a, 0x43, 0x7a, 0x13, 0x1a, 0x03, 0x0a, 0x03, 0x17,
+	0x13, 0x07, 0x13, 0x5a, 0x53, 0xfa, 0x43, 0x01, 0x29, 0x21, 0x2a, 0x01, 0x07, 0x3a, 0x23, 0x2a,
+	0x07, 0x01, 0x07, 0x0a, 0x13, 0x17, 0x1a, 0x17, 0x0a, 0x17, 0x11, 0x17, 0x29, 0x21, 0x07, 0x1a,
+	0x21, 0x03, 0x0a, 0x21, 0x03, 0x2a, 0x11, 0x07, 0x1a, 0x07, 0x11, 0x07, 0x0a, 0x21, 0x1a, 0x31,
+	0x29, 0x31, 0x07, 0x03, 0x31, 0x07, 0x31, 0x23, 0x21, 0x07, 0x03, 0x07, 0x61, 0x0a, 0x03, 0x3f,
+	0x05, 0x19, 0xe1, 0x03, 0xf1, 0x11, 0x1f, 0x35, 0x00, 0x05, 0x1a, 0xf1, 0x01, 0x07, 0x11, 0x17,
+	0x41, 0x17, 0x01, 0x1f, 0x08, 0x0f, 0x05, 0x00, 0x0b, 0x25, 0xf1, 0x21, 0x13, 0x07, 0x81, 0x0f,
+	0x0b, 0x2f, 0x0b, 0x15, 0x41, 0x34, 0x41, 0x14, 0x11, 0x17, 0x0a, 0x44, 0x21, 0x04, 0x11, 0x4f,
+	0x0b, 0x41, 0x17, 0x44, 0x11, 0x07, 0x44, 0x07, 0x01, 0x64, 0x01, 0x24, 0x1f, 0x08, 0x06, 0x1f,
+	0x10, 0x0b, 0x1a, 0x07, 0x0a, 0x07, 0x04, 0x11, 0x14, 0x51, 0x14, 0x51, 0x24, 0x11, 0x04, 0x01,
+	0x1f, 0x06, 0x08, 0x3f, 0x01, 0x07, 0x11, 0x0a, 0x14, 0x21, 0x04, 0x61, 0x14, 0x51, 0x14, 0x41,
+	0x0f, 0x0b, 0x3f, 0x51, 0x14, 0x21, 0x14, 0x01, 0x07, 0x21, 0x24, 0x31, 0x24, 0x21, 0x04, 0x01,
+	0x07, 0x01, 0x2f, 0x0b, 0x21, 0x0a, 0x03, 0x07, 0x01, 0x14, 0x21, 0x14, 0x21, 0x34, 0x21, 0x07,
+	0x24, 0x31, 0x04, 0x01, 0x03, 0x3f, 0x00, 0x0f, 0x51, 0x14, 0x21, 0x14, 0x11, 0x14, 0x51, 0x24,
+	0x01, 0x03, 0x0a, 0x01, 0x24, 0x01, 0x1f, 0x0a, 0x1f, 0x61, 0x14, 0x01, 0x0a, 0x03, 0x14, 0x11,
+	0x14, 0x11, 0x03, 0x21, 0x24, 0x01, 0x0a, 0x07, 0x01, 0x24, 0x11, 0x0f, 0x06, 0x1f, 0x61, 0x14,
+	0x11, 0x14, 0x21, 0x54, 0x01, 0x03, 0x0d, 0x44, 0x01, 0x24, 0x11, 0x1e, 0x0c, 0x07, 0x0a, 0x07,
+	0x31, 0x07, 0x04, 0x21, 0x03, 0x41, 0x34, 0x21, 0x03, 0x24, 0x07, 0x21, 0x04, 0x21, 0x2e, 0x0a,
+	0x07, 0x21, 0x07, 0xd1, 0x03, 0x07, 0x21, 0x13, 0x91, 0x02, 0x0e, 0xf1, 0xa1, 0x07, 0xf1, 0x91,
+	0x07, 0x01, 0x2a, 0xf1, 0xc1,
+};
@@ -0,0 +1,32 @@
+// Generated by imgconv from ussxmas4.bmp, do not edit.
+// 40x22, 16 colors, 419 bytes (2640 raw)
+
+const uint8_t img_ussxmas4[] PROGMEM = {
+	0x28, 0x16, 0x10, 0x9c, 0x0e, 0x0b, 0x0c, 0xff, 0x0c, 0xff, 0x9f, 0x00, 0xa7, 0xff, 0xa6, 0x96,
+	0x03, 0xe7, 0xbd, 0x11, 0x0b, 0x49, 0xff, 0x48, 0xff, 0xa8, 0xa8, 0xff, 0x77, 0x77, 0x44, 0x74,
+	0x11, 0xe3, 0xfe, 0xe0, 0xba, 0x55, 0x52, 0xf5, 0xfc, 0x05, 0xf5, 0x04, 0x03, 0x68, 0xff, 0x68,
+	0xf7, 0x5e, 0x5d, 0xfa, 0x5a, 0x13, 0xfa, 0x9a, 0x43, 0x7a, 0x13, 0x1a, 0x03, 0x0a, 0x33, 0x1a,
+	0x13, 0x5a, 0x53, 0xfa, 0x2a, 0x23, 0x0a, 0x19, 0x0e, 0x01, 0x06, 0x03, 0x1a, 0x01, 0x06, 0x0a,
+	0x03, 0x01, 0x06, 0x33, 0x0e, 0x0a, 0x0e, 0x01, 0x16, 0x0e, 0x03, 0x16, 0x1a, 0x16, 0x0a, 0x23,
+	0x01, 0x06, 0x0e, 0x29, 0x11, 0x03, 0x06, 0x1a, 0x21, 0x0e, 0x06, 0x21, 0x0e, 0x11, 0x0e, 0x11,
+	0x06, 0x0e, 0x1a, 0x06, 0x01, 0x06, 0x0a, 0x31, 0x03, 0x31, 0x29, 0x21, 0x03, 0x0e, 0x03, 0x0e,
+	0x21, 0x06, 0x41, 0x06, 0x03, 0x21, 0x06, 0x03, 0x1a, 0x51, 0x16, 0x3d, 0x05, 0x19, 0x21, 0x1e,
+	0x01, 0x0a, 0x21, 0x06, 0x31, 0x06, 0xb1, 0x03, 0x0e, 0x31, 0x1d, 0x15, 0x0d, 0x05, 0x10, 0x06,
+	0x0e, 0x11, 0x0a, 0x03, 0x91, 0x06, 0x11, 0x06, 0x11, 0x16, 0x01, 0x06, 0x0a, 0x0e, 0x31, 0x1d,
+	0x08, 0x0d, 0x05, 0x00, 0x0b, 0x25, 0xf1, 0x21, 0x13, 0x06, 0x11, 0x0e, 0x06, 0x01, 0x16, 0x11,
+	0x0d, 0x0f, 0x2d, 0x0f, 0x15, 0x06, 0x31, 0x34, 0x41, 0x14, 0x11, 0x16, 0x0a, 0x44, 0x21, 0x04,
+	0x11, 0x4d, 0x0b, 0x11, 0x03, 0x0e, 0x01, 0x1e, 0x44, 0x11, 0x06, 0x44, 0x06, 0x01, 0x64, 0x01,
+	0x24, 0x1d, 0x0f, 0x07, 0x1d, 0x10, 0x0f, 0x1a, 0x06, 0x0a, 0x0e, 0x04, 0x11, 0x14, 0x11, 0x06,
+	0x21, 0x14, 0x51, 0x24, 0x11, 0x04, 0x01, 0x1d, 0x07, 0x08, 0x3d, 0x31, 0x0a, 0x14, 0x01, 0x06,
+	0x0e, 0x04, 0x61, 0x14, 0x51, 0x14, 0x41, 0x0d, 0x0f, 0x3d, 0x51, 0x14, 0x01, 0x13, 0x14, 0x01,
+	0x16, 0x11, 0x24, 0x31, 0x24, 0x21, 0x04, 0x01, 0x06, 0x01, 0x2d, 0x0b, 0x21, 0x06, 0x01, 0x06,
+	0x01, 0x14, 0x21, 0x14, 0x21, 0x34, 0x21, 0x0e, 0x24, 0x31, 0x04, 0x01, 0x03, 0x3d, 0x00, 0x0d,
+	0x11, 0x06, 0x21, 0x14, 0x21, 0x14, 0x11, 0x14, 0x01, 0x16, 0x21, 0x24, 0x01, 0x0e, 0x06, 0x01,
+	0x24, 0x01, 0x1d, 0x0a, 0x1d, 0x61, 0x14, 0x01, 0x0a, 0x03, 0x14, 0x11, 0x14, 0x01, 0x06, 0x03,
+	0x21, 0x24, 0x01, 0x06, 0x0e, 0x01, 0x24, 0x11, 0x0d, 0x07, 0x1d, 0x61, 0x14, 0x11, 0x14, 0x21,
+	0x54, 0x11, 0x06, 0x44, 0x01, 0x24, 0x11, 0x1c, 0x02, 0x06, 0x01, 0x06, 0x31, 0x06, 0x04, 0x21,
+	0x03, 0x21, 0x0a, 0x0e, 0x34, 0x21, 0x06, 0x24, 0x0e, 0x21, 0x04, 0x21, 0x2c, 0x16, 0x21, 0x06,
+	0x51, 0x06, 0x11, 0x03, 0x0a, 0x0e, 0x11, 0x16, 0x31, 0x06, 0x91, 0x06, 0x0c, 0xf1, 0xa1, 0x06,
+	0x11, 0x36, 0x41, 0x03, 0x06, 0xa1, 0x06, 0x01, 0x06, 0xe1, 0x33, 0x41, 0x0a, 0x06, 0x21, 0x03,
+	0x0a, 0x03, 0x01,
+};
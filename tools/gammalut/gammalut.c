@@ -0,0 +1,71 @@
+/*********************************************************************
+ * gammalut
+ *
+ * Host tool: writes the colour correction table for the LED panel as a
+ * PROGMEM header. Picture colours go through it as they are decoded
+ * (rleImageSetLut in rleimage.c), together with the brightness.
+ *
+ * Usage: gammalut [-g gamma] [-w r,g,b] > colorlut.h
+ *
+ *   -g  gamma of the pictures, default 2.2. 1.0 leaves them linear.
+ *   -w  white balance, what full white of each channel is scaled to,
+ *       default 255,176,240: the green and blue dies of a WS2812 are
+ *       brighter than the red one, so plain 255,255,255 looks bluish.
+ *
+ * The table is a 16 bit gamma curve, 256 words:
+ *   gamma_curve[in] = 65535 * (in / 255) ^ gamma, rounded
+ * and the white balance, one byte per channel in LED order (G, R, B).
+ * The firmware multiplies the two by the brightness and rounds once
+ * at the end, so dark colours don't get cut to 0 by an 8 bit table
+ * and then again by the brightness.
+ *********************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+static void usage(void) {
+  fprintf(stderr, "usage: gammalut [-g gamma] [-w r,g,b]\n");
+  exit(2);
+}
+
+int main(int argc, char **argv) {
+  double gamma = 2.2;
+  int white[3] = {255, 176, 240}; // R, G, B
+  static const int order[3] = {1, 0, 2}; // G, R, B tables from white[]
+  int i, ch, v;
+
+  for (i = 1; i < argc; i++) {
+    if (!strcmp(argv[i], "-g") && i + 1 < argc) {
+      gamma = atof(argv[++i]);
+    } else if (!strcmp(argv[i], "-w") && i + 1 < argc) {
+      if (sscanf(argv[++i], "%d,%d,%d", &white[0], &white[1], &white[2]) != 3) {
+        usage();
+      }
+    } else {
+      usage();
+    }
+  }
+  if (gamma <= 0) {
+    usage();
+  }
+  for (ch = 0; ch < 3; ch++) {
+    if (white[ch] < 0 || white[ch] > 255) {
+      usage();
+    }
+  }
+
+  printf("// Generated by gammalut, do not edit.\n");
+  printf("// gamma %.2f, white %d,%d,%d (R,G,B)\n\n", gamma, white[0], white[1], white[2]);
+  printf("const uint16_t gamma_curve[256] PROGMEM = {\n");
+  for (i = 0; i < 256; i++) {
+    v = (int)(65535 * pow(i / 255.0, gamma) + 0.5);
+    printf("%s0x%04x,%s", (i % 8) ? " " : "\t", v, (i % 8 == 7) ? "\n" : "");
+  }
+  printf("};\n\n");
+  printf("// G, R, B\n");
+  printf("const uint8_t color_white[3] PROGMEM = {%d, %d, %d};\n",
+         white[order[0]], white[order[1]], white[order[2]]);
+  return 0;
+}
@@ -0,0 +1,421 @@
+/*********************************************************************
+ * imgconv
+ *
+ * Host tool: converts a 24-bit BMP or binary PPM (P6) picture into a
+ * PROGMEM header for the LED panel, in the RLE16 format read by
+ * rleimage.c on the device.
+ *
+ * Usage: imgconv [-c colors | -l] [-n name] picture.bmp > picture.h
+ *
+ * RLE16 format:
+ *   byte 0      width
+ *   byte 1      height
+ *   byte 2      number of palette entries (1-16)
+ *   palette     3 bytes per entry, in LED order: G, R, B
+ *   runs        one byte per run: high nibble = run length-1 (1-16 pixels),
+ *               low nibble = palette index
+ *   literals    with fewer than 16 palette entries, index 15 is a literal
+ *               run: the run byte is followed by G, R, B of each pixel
+ *
+ * Pixels are stored bottom row first, left to right, the same order the
+ * BMP data was pasted into main.c, so the panel wiring code is unchanged.
+ *
+ * -l keeps every color as it is: the 15 most common colors go in the
+ * palette and the rest in literal runs, or all of them in the palette
+ * if there are 16 or fewer. That costs flash (the ussxmas pictures only
+ * get 1.5-2x smaller, against 6-8x with 16 colors) and the panel puts
+ * literal pixels through the color table one by one, so the pictures in
+ * the firmware are made without it.
+ *
+ * Otherwise pictures with more than 'colors' distinct colors are reduced:
+ * the box of colors with the widest channel range is split at the middle
+ * of that range, until there are 'colors' boxes, and each palette entry
+ * is the average of its box. Busy pictures lose a lot that way, up to
+ * 57/255 on a channel in images/ussxmas2.bmp, and at a high brightness
+ * ('l' cmd) it shows.
+ *********************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+
+#define MAX_COLORS    16
+#define MAX_RUN       16
+#define LITERAL       15 // run index of a literal run, with fewer than 16 colors
+
+typedef struct {
+  unsigned char r, g, b;
+} rgb;
+
+typedef struct {
+  int first;  // first entry in the pixel index list
+  int count;
+} box;
+
+static int width, height;
+static rgb *pixels; // bottom row first
+
+static void die(const char *msg, const char *arg) {
+  fprintf(stderr, "imgconv: %s%s\n", msg, arg ? arg : "");
+  exit(1);
+}
+
+static unsigned long le(const unsigned char *p, int n) {
+  unsigned long v = 0;
+  while (n--) {
+    v = (v << 8) | p[n];
+  }
+  return v;
+}
+
+/*********************************************************************
+ * Load a 24-bit uncompressed BMP. Rows are kept in file order
+ * (bottom-up for a positive height).
+ *********************************************************************/
+static void loadBmp(FILE *f, const char *name) {
+  unsigned char hdr[54];
+  long offset, stride;
+  int y, x, h, topdown;
+  unsigned char *row;
+
+  if (fread(hdr, 1, sizeof(hdr), f) != sizeof(hdr)) {
+    die("short BMP header in ", name);
+  }
+  offset = le(&hdr[10], 4);
+  width = (int)le(&hdr[18], 4);
+  h = (int)le(&hdr[22], 4);
+  topdown = (h < 0);
+  height = topdown ? -h : h;
+  if (le(&hdr[28], 2) != 24 || le(&hdr[30], 4) != 0) {
+    die("only 24-bit uncompressed BMP is supported: ", name);
+  }
+  stride = (width * 3 + 3) & ~3L;
+  row = malloc(stride);
+  pixels = malloc(sizeof(rgb) * width * height);
+  fseek(f, offset, SEEK_SET);
+  for (y = 0; y < height; y++) {
+    // keep bottom row first no matter how the file is stored
+    rgb *dst = &pixels[(topdown ? height - 1 - y : y) * width];
+    if (fread(row, 1, stride, f) != (size_t)stride) {
+      die("short BMP pixel data in ", name);
+    }
+    for (x = 0; x < width; x++) {
+      dst[x].b = row[x * 3];
+      dst[x].g = row[x * 3 + 1];
+      dst[x].r = row[x * 3 + 2];
+    }
+  }
+  free(row);
+}
+
+static int ppmInt(FILE *f) {
+  int c, v = 0;
+  do { // skip white space and comments
+    c = fgetc(f);
+    if (c == '#') {
+      while (c != '\n' && c != EOF) {
+        c = fgetc(f);
+      }
+    }
+  } while (isspace(c));
+  while (isdigit(c)) {
+    v = v * 10 + (c - '0');
+    c = fgetc(f);
+  }
+  return v;
+}
+
+/*********************************************************************
+ * Load a binary PPM. PPM is stored top row first, so flip it.
+ *********************************************************************/
+static void loadPpm(FILE *f, const char *name) {
+  int y, x, maxval;
+  unsigned char px[3];
+
+  width = ppmInt(f);
+  height = ppmInt(f);
+  maxval = ppmInt(f);
+  if (maxval != 255) {
+    die("only 8-bit PPM is supported: ", name);
+  }
+  pixels = malloc(sizeof(rgb) * width * height);
+  for (y = height - 1; y >= 0; y--) {
+    for (x = 0; x < width; x++) {
+      if (fread(px, 1, 3, f) != 3) {
+        die("short PPM pixel data in ", name);
+      }
+      pixels[y * width + x].r = px[0];
+      pixels[y * width + x].g = px[1];
+      pixels[y * width + x].b = px[2];
+    }
+  }
+}
+
+static void load(const char *name) {
+  unsigned char magic[2];
+  FILE *f = fopen(name, "rb");
+
+  if (!f) {
+    die("can't open ", name);
+  }
+  if (fread(magic, 1, 2, f) != 2) {
+    die("empty file ", name);
+  }
+  if (magic[0] == 'B' && magic[1] == 'M') {
+    rewind(f);
+    loadBmp(f, name);
+  } else if (magic[0] == 'P' && magic[1] == '6') {
+    loadPpm(f, name);
+  } else {
+    die("not a BMP or P6 PPM file: ", name);
+  }
+  fclose(f);
+  if (width < 1 || width > 255 || height < 1 || height > 255) {
+    die("picture must be 1-255 pixels each way: ", name);
+  }
+}
+
+/*********************************************************************
+ * Palette reduction, splitting boxes of colors at the middle of their
+ * widest channel's range.
+ *********************************************************************/
+static int *order; // pixel numbers, grouped by box
+static int sortChannel;
+
+static unsigned char channel(int pixel, int ch) {
+  return ch == 0 ? pixels[pixel].r : ch == 1 ? pixels[pixel].g : pixels[pixel].b;
+}
+
+static int byChannel(const void *a, const void *b) {
+  return channel(*(const int *)a, sortChannel) - channel(*(const int *)b, sortChannel);
+}
+
+// widest channel range in the box, returns the range, sets *ch
+static int boxRange(const box *bx, int *ch) {
+  int c, i, lo, hi, best = -1;
+  for (c = 0; c < 3; c++) {
+    lo = 255;
+    hi = 0;
+    for (i = bx->first; i < bx->first + bx->count; i++) {
+      int v = channel(order[i], c);
+      if (v < lo) lo = v;
+      if (v > hi) hi = v;
+    }
+    if (hi - lo > best) {
+      best = hi - lo;
+      *ch = c;
+    }
+  }
+  return best;
+}
+
+static int buildPalette(rgb *pal, int colors) {
+  box boxes[MAX_COLORS];
+  int nboxes = 1, n = width * height, i, b, ch = 0;
+
+  order = malloc(sizeof(int) * n);
+  for (i = 0; i < n; i++) {
+    order[i] = i;
+  }
+  boxes[0].first = 0;
+  boxes[0].count = n;
+
+  // keep splitting the box with the widest channel range
+  while (nboxes < colors) {
+    int widest = -1, range = 0, wch = 0, mid, split;
+    for (b = 0; b < nboxes; b++) {
+      int r = boxRange(&boxes[b], &ch);
+      if (boxes[b].count > 1 && r > range) {
+        range = r;
+        widest = b;
+        wch = ch;
+      }
+    }
+    if (widest < 0) {
+      break; // every box is a single color
+    }
+    // split halfway along the channel's range rather than at the median
+    // count, so a few bright pixels (lights, snow) keep their own color
+    sortChannel = wch;
+    qsort(&order[boxes[widest].first], boxes[widest].count, sizeof(int), byChannel);
+    mid = (channel(order[boxes[widest].first], wch) +
+           channel(order[boxes[widest].first + boxes[widest].count - 1], wch) + 1) / 2;
+    for (split = 1; channel(order[boxes[widest].first + split], wch) < mid; split++);
+    boxes[nboxes].first = boxes[widest].first + split;
+    boxes[nboxes].count = boxes[widest].count - split;
+    boxes[widest].count = split;
+    nboxes++;
+  }
+
+  // each palette entry is the average of its box
+  for (b = 0; b < nboxes; b++) {
+    long sum[3] = {0, 0, 0};
+    for (i = boxes[b].first; i < boxes[b].first + boxes[b].count; i++) {
+      for (ch = 0; ch < 3; ch++) {
+        sum[ch] += channel(order[i], ch);
+      }
+    }
+    pal[b].r = (unsigned char)((sum[0] + boxes[b].count / 2) / boxes[b].count);
+    pal[b].g = (unsigned char)((sum[1] + boxes[b].count / 2) / boxes[b].count);
+    pal[b].b = (unsigned char)((sum[2] + boxes[b].count / 2) / boxes[b].count);
+  }
+  free(order);
+  return nboxes;
+}
+
+static int sameColor(rgb a, rgb b) {
+  return a.r == b.r && a.g == b.g && a.b == b.b;
+}
+
+/*********************************************************************
+ * Lossless palette: every color if there are up to MAX_COLORS of them,
+ * else the LITERAL most common ones. Pixels are indexed here, the ones
+ * left out get LITERAL.
+ *********************************************************************/
+static int exactPalette(rgb *pal, unsigned char *index) {
+  int n = width * height, ncolors = 0, npal, i, j, best;
+  rgb *colors = malloc(sizeof(rgb) * n);
+  int *count = calloc(n, sizeof(int));
+
+  for (i = 0; i < n; i++) {
+    for (j = 0; j < ncolors && !sameColor(colors[j], pixels[i]); j++);
+    if (j == ncolors) {
+      colors[ncolors++] = pixels[i];
+    }
+    count[j]++;
+  }
+  npal = (ncolors <= MAX_COLORS) ? ncolors : LITERAL;
+  for (i = 0; i < npal; i++) { // most common first, ties in picture order
+    best = -1;
+    for (j = 0; j < ncolors; j++) {
+      if (count[j] && (best < 0 || count[j] > count[best])) {
+        best = j;
+      }
+    }
+    pal[i] = colors[best];
+    count[best] = 0;
+  }
+  for (i = 0; i < n; i++) {
+    for (j = 0; j < npal && !sameColor(pal[j], pixels[i]); j++);
+    index[i] = (j < npal) ? j : LITERAL;
+  }
+  free(colors);
+  free(count);
+  return npal;
+}
+
+static int nearest(const rgb *pal, int n, rgb c) {
+  int i, best = 0;
+  long bestd = -1;
+  for (i = 0; i < n; i++) {
+    long dr = pal[i].r - c.r, dg = pal[i].g - c.g, db = pal[i].b - c.b;
+    long d = dr * dr + dg * dg + db * db;
+    if (bestd < 0 || d < bestd) {
+      bestd = d;
+      best = i;
+    }
+  }
+  return best;
+}
+
+/*********************************************************************
+ * Output
+ *********************************************************************/
+static int col; // bytes on the current output line
+
+static void emit(unsigned char v) {
+  printf("%s0x%02x,", col ? " " : "\t", v);
+  if (++col == 16) {
+    printf("\n");
+    col = 0;
+  }
+}
+
+static void usage(void) {
+  fprintf(stderr, "usage: imgconv [-c colors | -l] [-n name] picture.bmp|picture.ppm\n");
+  exit(2);
+}
+
+int main(int argc, char **argv) {
+  const char *file = NULL, *name = NULL;
+  char sym[64];
+  rgb pal[MAX_COLORS];
+  int colors = MAX_COLORS, lossless = 0, npal, i, j, n, runs, literals, run, idx;
+  unsigned char *index;
+
+  for (i = 1; i < argc; i++) {
+    if (!strcmp(argv[i], "-c") && i + 1 < argc) {
+      colors = atoi(argv[++i]);
+    } else if (!strcmp(argv[i], "-l")) {
+      lossless = 1;
+    } else if (!strcmp(argv[i], "-n") && i + 1 < argc) {
+      name = argv[++i];
+    } else if (argv[i][0] == '-' || file) {
+      usage();
+    } else {
+      file = argv[i];
+    }
+  }
+  if (!file || colors < 1 || colors > MAX_COLORS) {
+    usage();
+  }
+
+  // symbol name defaults to the file name without path or extension
+  if (!name) {
+    name = strrchr(file, '/') ? strrchr(file, '/') + 1 : file;
+  }
+  for (i = 0; name[i] && name[i] != '.' && i < (int)sizeof(sym) - 1; i++) {
+    sym[i] = isalnum((unsigned char)name[i]) ? name[i] : '_';
+  }
+  sym[i] = 0;
+
+  load(file);
+  n = width * height;
+  index = malloc(n);
+  if (lossless) {
+    npal = exactPalette(pal, index);
+  } else {
+    npal = buildPalette(pal, colors);
+    for (i = 0; i < n; i++) {
+      index[i] = (unsigned char)nearest(pal, npal, pixels[i]);
+    }
+  }
+  for (i = 0, runs = 0, literals = 0; i < n; i += run, runs++) {
+    for (run = 1; i + run < n && run < MAX_RUN && index[i + run] == index[i]; run++);
+    if (npal < MAX_COLORS && index[i] == LITERAL) {
+      literals += run;
+    }
+  }
+
+  printf("// Generated by imgconv from %s, do not edit.\n",
+         strrchr(file, '/') ? strrchr(file, '/') + 1 : file);
+  printf("// %dx%d, %d colors", width, height, npal);
+  if (literals) {
+    printf(" and %d literal pixels", literals);
+  }
+  printf(", %d bytes (%d raw)\n\n", 3 + npal * 3 + runs + literals * 3, n * 3);
+  printf("const uint8_t img_%s[] PROGMEM = {\n", sym);
+  emit((unsigned char)width);
+  emit((unsigned char)height);
+  emit((unsigned char)npal);
+  for (i = 0; i < npal; i++) {
+    emit(pal[i].g);
+    emit(pal[i].r);
+    emit(pal[i].b);
+  }
+  for (i = 0; i < n; i += run) {
+    idx = index[i];
+    for (run = 1; i + run < n && run < MAX_RUN && index[i + run] == idx; run++);
+    emit((unsigned char)(((run - 1) << 4) | idx));
+    if (npal < MAX_COLORS && idx == LITERAL) {
+      for (j = i; j < i + run; j++) {
+        emit(pixels[j].g);
+        emit(pixels[j].r);
+        emit(pixels[j].b);
+      }
+    }
+  }
+  printf("%s};\n", col ? "\n" : "");
+  return 0;
+}
@@ -0,0 +1,266 @@
+/*********************************************************************
+ * uartbench
+ *
+ * Host tool: measures how fast frames can be pushed to the panel over
+ * the serial port, using the 'f' stream command of the command protocol.
+ *
+ * Usage: uartbench [-d device] [-a addr] [-b baud] [-u baud] [-n frames] [-p]
+ *
+ *   -d  serial device, default /dev/ttyUSB0
+ *   -a  panel address, as the character sent after '!', default 1
+ *   -b  rate the panel is at now, default 19200
+ *   -u  ask the panel to switch to this rate first ('u' command)
+ *   -n  number of half frames to send, default 10
+ *   -p  don't send frames, print the panel's frame profile as CSV
+ *       ("gt" for each slot, see profile.h), cycles per stage
+ *
+ * Each half frame is NUM_LEDS bytes, sent nibble encoded, so it takes
+ * 2*NUM_LEDS+8 bytes on the wire. At the end the panel's own receive
+ * error counts are read back with "ge".
+ *
+ * On Linux any baud rate can be used (termios2), elsewhere only the
+ * standard B* rates.
+ *********************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <errno.h>
+#include <time.h>
+#include <sys/ioctl.h>
+#include <sys/select.h>
+#ifdef __linux__
+#include <asm/termbits.h>
+// <termios.h> clashes with termios2, so do these by hand
+#define tcflush(fd, queue)  ioctl(fd, TCFLSH, queue)
+#define tcdrain(fd)         ioctl(fd, TCSBRK, 1)
+#else
+#include <termios.h>
+#endif
+
+#define NUM_LEDS      (40*11*3) // bytes per string, see WS2812.h
+#define REPLY_MS      2000      // panel has this long to answer
+#define REPLY_MAX     80
+
+static int fd;
+
+static void die(const char *msg, const char *arg) {
+  fprintf(stderr, "uartbench: %s%s\n", msg, arg ? arg : "");
+  exit(1);
+}
+
+static double now(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+/*********************************************************************
+ * Serial port setup, raw 8N1.
+ *********************************************************************/
+#ifdef __linux__
+static void setBaud(long baud) {
+  struct termios2 tio;
+
+  if (ioctl(fd, TCGETS2, &tio) < 0) {
+    die("can't read port settings", NULL);
+  }
+  tio.c_iflag = 0;
+  tio.c_oflag = 0;
+  tio.c_lflag = 0;
+  tio.c_cflag = CS8 | CREAD | CLOCAL | BOTHER | (BOTHER << IBSHIFT);
+  tio.c_ispeed = tio.c_ospeed = baud;
+  tio.c_cc[VMIN] = 0;
+  tio.c_cc[VTIME] = 0;
+  if (ioctl(fd, TCSETS2, &tio) < 0) {
+    die("can't set baud rate", NULL);
+  }
+}
+#else
+static void setBaud(long baud) {
+  static const struct { long baud; speed_t code; } rates[] = {
+    {9600, B9600}, {19200, B19200}, {38400, B38400}, {57600, B57600},
+    {115200, B115200}, {230400, B230400},
+  };
+  struct termios tio;
+  unsigned i;
+
+  for (i = 0; i < sizeof(rates) / sizeof(rates[0]) && rates[i].baud != baud; i++);
+  if (i == sizeof(rates) / sizeof(rates[0])) {
+    die("baud rate not supported on this system", NULL);
+  }
+  tcgetattr(fd, &tio);
+  cfmakeraw(&tio);
+  tio.c_cflag |= CREAD | CLOCAL;
+  cfsetspeed(&tio, rates[i].code);
+  tio.c_cc[VMIN] = 0;
+  tio.c_cc[VTIME] = 0;
+  if (tcsetattr(fd, TCSANOW, &tio) < 0) {
+    die("can't set baud rate", NULL);
+  }
+}
+#endif
+
+static void sendAll(const char *p, int n) {
+  while (n > 0) {
+    int w = write(fd, p, n);
+    if (w < 0) {
+      if (errno == EAGAIN || errno == EINTR) continue;
+      die("write failed", NULL);
+    }
+    p += w;
+    n -= w;
+  }
+}
+
+// read one '$' terminated reply, returns its length or -1 on timeout
+static int readReply(char *reply) {
+  double end = now() + REPLY_MS / 1000.0;
+  int n = 0;
+
+  while (now() < end) {
+    fd_set rd;
+    struct timeval tv = {0, 10000};
+    char c;
+    FD_ZERO(&rd);
+    FD_SET(fd, &rd);
+    if (select(fd + 1, &rd, NULL, NULL, &tv) > 0 && read(fd, &c, 1) == 1) {
+      if (n < REPLY_MAX - 1) {
+        reply[n++] = c;
+      }
+      if (c == '$') {
+        reply[n] = 0;
+        return n;
+      }
+    }
+  }
+  reply[n] = 0;
+  return -1;
+}
+
+// send "!" addr cmd "$" and wait for the reply
+static int command(int addr, const char *cmd, char *reply) {
+  char hdr[2] = {'!', (char)addr};
+  sendAll(hdr, 2);
+  sendAll(cmd, strlen(cmd));
+  sendAll("$", 1);
+  return readReply(reply);
+}
+
+static void usage(void) {
+  fprintf(stderr, "usage: uartbench [-d device] [-a addr] [-b baud] [-u baud] [-n frames] [-p]\n");
+  exit(2);
+}
+
+int main(int argc, char **argv) {
+  const char *dev = "/dev/ttyUSB0";
+  int addr = '1', frames = 10, profile = 0, i, j, good = 0, bad = 0, timeouts = 0;
+  long baud = 19200, newBaud = 0;
+  char reply[REPLY_MAX], expect[16], cmd[24];
+  static char frame[2 * NUM_LEDS + 8];
+  double start, secs;
+
+  for (i = 1; i < argc; i++) {
+    if (!strcmp(argv[i], "-p")) {
+      profile = 1;
+    } else if (i + 1 >= argc) {
+      usage();
+    } else if (!strcmp(argv[i], "-d")) {
+      dev = argv[++i];
+    } else if (!strcmp(argv[i], "-a")) {
+      addr = (unsigned char)argv[++i][0];
+    } else if (!strcmp(argv[i], "-b")) {
+      baud = atol(argv[++i]);
+    } else if (!strcmp(argv[i], "-u")) {
+      newBaud = atol(argv[++i]);
+    } else if (!strcmp(argv[i], "-n")) {
+      frames = atoi(argv[++i]);
+    } else {
+      usage();
+    }
+  }
+  if (addr < 1 || addr > 255 || baud <= 0 || newBaud < 0 || frames < 1) {
+    usage();
+  }
+
+  fd = open(dev, O_RDWR | O_NOCTTY | O_NONBLOCK);
+  if (fd < 0) {
+    die("can't open ", dev);
+  }
+  setBaud(baud);
+  usleep(100000);
+  tcflush(fd, TCIOFLUSH);
+
+  if (newBaud) {
+    // panel acks at the old rate, then switches and waits for a cmd
+    snprintf(cmd, sizeof(cmd), "u%ld", newBaud);
+    if (command(addr, cmd, reply) < 0 || reply[0] != 'u') {
+      die("panel refused the new rate: ", reply);
+    }
+    tcdrain(fd);
+    setBaud(newBaud);
+    usleep(10000);
+    if (command(addr, "gl", reply) < 0) {
+      die("no answer at the new rate, panel will fall back", NULL);
+    }
+    baud = newBaud;
+  }
+
+  if (profile) {
+    // slots run until the panel says err-badslot
+    printf("slot,frames,build_last,build_max,output_last,output_max\n");
+    for (i = 0; i < 256; i++) {
+      snprintf(cmd, sizeof(cmd), "gt%d", i);
+      if (command(addr, cmd, reply) < 0) {
+        die("no answer to ", cmd);
+      }
+      if (reply[0] != 'g') {
+        break;
+      }
+      reply[strlen(reply) - 1] = 0; // drop the '$'
+      printf("%d,%s\n", i, reply + 1);
+    }
+    close(fd);
+    return 0;
+  }
+
+  // one half frame, a moving gradient so the panel shows it's alive
+  snprintf(expect, sizeof(expect), "f%d$", NUM_LEDS);
+  start = now();
+  for (i = 0; i < frames; i++) {
+    int n = 0;
+    frame[n++] = 'f';
+    frame[n++] = '0' + (i & 1); // alternate the strings
+    for (j = 0; j < 4; j++) {
+      frame[n++] = '0'; // offset 0
+    }
+    for (j = 0; j < NUM_LEDS; j++) {
+      unsigned char v = (unsigned char)(j + i * 8);
+      frame[n++] = '0' + (v >> 4);
+      frame[n++] = '0' + (v & 0x0F);
+    }
+    frame[n] = 0;
+    if (command(addr, frame, reply) < 0) {
+      timeouts++;
+      tcflush(fd, TCIFLUSH);
+    } else if (strcmp(reply, expect)) {
+      bad++;
+    } else {
+      good++;
+    }
+  }
+  secs = now() - start;
+
+  printf("%ld baud, %d half frames in %.2f s\n", baud, frames, secs);
+  printf("  %.0f payload bytes/s, %.0f wire bytes/s, %.1f frames/s\n",
+         good * (double)NUM_LEDS / secs, frames * (2.0 * NUM_LEDS + 8) / secs,
+         good / secs);
+  printf("  %d ok, %d bad replies, %d timeouts\n", good, bad, timeouts);
+  if (command(addr, "ge", reply) > 0) {
+    printf("  panel rx errors (overflow,framing,overrun): %s\n", reply);
+  }
+  close(fd);
+  return (bad || timeouts) ? 1 : 0;
+}
@@ -0,0 +1,33 @@
+/*********************************************************************
+ * avr/io.h for wstiming
+ *
+ * The ATmega328P I/O addresses the output routines use, as in/out
+ * addresses (the routines define __SFR_OFFSET 0). Only what's needed
+ * to run the output_grb*.s files on the simulator.
+ *********************************************************************/
+#ifndef WSTIMING_AVR_IO_H
+#define WSTIMING_AVR_IO_H
+
+#define PINB    0x03
+#define DDRB    0x04
+#define PORTB   0x05
+#define PINC    0x06
+#define DDRC    0x07
+#define PORTC   0x08
+#define PIND    0x09
+#define DDRD    0x0A
+#define PORTD   0x0B
+#define SPL     0x3D
+#define SPH     0x3E
+#define SREG    0x3F
+
+#define PIND0   0
+#define PIND1   1
+#define PIND2   2
+#define PIND3   3
+#define PIND4   4
+#define PIND5   5
+#define PIND6   6
+#define PIND7   7
+
+#endif
@@ -0,0 +1,1074 @@
+/*********************************************************************
+ * wstiming
+ *
+ * Host tool: runs the WS2812 output routines (output_grb*.s) on a small
+ * cycle-counting AVR simulator and checks what comes out of the pins.
+ *
+ * Usage: wstiming [-n runs] [-s seed] [-v] [-c] file.s symbol [symbol...]
+ *
+ *   -n  random buffers per routine, default 200
+ *   -s  random seed, default 1
+ *   -v  print every pulse that's out of its window, not just the count
+ *   -c  print the whole string figures as CSV instead, one line per
+ *       routine (file,routine,count,unit,call_cycles,frame_cycles,ms)
+ *
+ * The .s file goes through the C preprocessor (with avr/io.h from
+ * here) and the simulator runs the assembly source itself, so nothing
+ * has to be built for the AVR. It knows the instructions the output
+ * routines use, with their ATmega328P cycle counts, and stops on
+ * anything else.
+ *
+ * Each routine is called like avr-gcc would, with random data, random
+ * counts and, for the routines that read led_brightness, a random
+ * brightness and dither state. Every write to PORTB/C/D is logged with
+ * its cycle, and the pins that toggled are decoded back into bits:
+ *
+ *   - the bits have to be the bytes the routine was given, scaled as
+ *     (byte * brightness + dither) >> 8 where the routine scales
+ *   - every high and low time has to be in the WS2812B datasheet window
+ *     below
+ *   - the other pins of the port, the interrupt flag, r1, the call-saved
+ *     registers and the stack have to be as they were
+ *
+ * At the end it sends a whole string (NUM_LEDS bytes) and reports the
+ * cycles from the first rising edge to the last falling one, and from
+ * the call to the return. The call takes the same time whatever the
+ * data, so that one is exact: the output stage of a frame, without the
+ * interrupts that run between chunks (WS2812.c). The build stage is C,
+ * which this can't run; the panel times it ('g' 't', profile.h).
+ *
+ * Exit status is 1 if anything failed.
+ *********************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <stdint.h>
+
+#define F_CPU         16000000L
+#define NUM_LEDS      (40*11*3) // bytes per string, see WS2812.h
+#define NS(cycles)    ((cycles) * 1000L / (F_CPU / 1000000L))
+
+/*********************************************************************
+ * WS2812B datasheet windows, ns. A high time decides the bit: a '0' is
+ * 400 +-150, a '1' 800 +-150. The low time after a '0' is 850 +-150 and
+ * after a '1' 450 +-150. A low can run longer than that at the end of
+ * a byte, while the next one is fetched, but it must stay well short of
+ * the reset time (50us, the oldest parts), or the LEDs latch mid-frame.
+ *********************************************************************/
+#define T0H_MIN_NS    250
+#define T0H_MAX_NS    550
+#define T1H_MIN_NS    650
+#define T1H_MAX_NS    950
+#define T0L_MIN_NS    700
+#define T1L_MIN_NS    300
+#define TL_MAX_NS     5000
+
+#define MAX_INSNS     1024
+#define MAX_SYMS      256
+#define MAX_EDGES     (NUM_LEDS * 8 * 4 + 64)
+#define RAMEND        0x1FFF // more than a 328P, a whole dual-lane panel fits
+#define MAX_CYCLES    5000000L
+#define RET_MARK      0xFFFF // return address of the call into a routine
+#define PORTB_ADDR    0x05
+#define PORTC_ADDR    0x08
+#define PORTD_ADDR    0x0B
+#define SREG_ADDR     0x3F
+#define DATA_PINS     0x1C // bits 2-4, the pins the routines drive
+
+// data the routines read or write with lds/sts
+#define ADDR_BRIGHTNESS  0x100
+#define ADDR_DITHER      0x101
+#define ADDR_DITHER_STEP 0x102
+#define ADDR_BUF         0x110 // data and palettes go from here
+
+enum { O_REG = 1, O_PTR, O_IMM };
+enum { P_X, P_XP, P_MX, P_Y, P_YP, P_MY, P_Z, P_ZP, P_MZ };
+
+typedef struct {
+  int kind;
+  long v; // register number, pointer mode or value
+} operand;
+
+typedef struct {
+  char op[8];
+  operand a[2];
+  int nargs;
+  int words; // 2 for lds/sts
+  int line;
+} insn;
+
+typedef struct {
+  char name[40];
+  long value;
+} sym;
+
+static insn prog[MAX_INSNS];
+static int nprog;
+static sym syms[MAX_SYMS]; // labels (insn index) and .equ values
+static int nsyms;
+static const char *srcName;
+static int verbose;
+
+// machine
+static uint8_t r[32];
+static uint8_t io[64];
+static uint8_t sram[RAMEND + 1];
+static int flagC, flagZ, flagN, flagV, flagT, flagI;
+static uint16_t sp;
+static long cycle;
+static long callCycles; // of the last call, to its return
+static int readBrightness;
+
+// pin trace
+typedef struct {
+  long cycle;
+  uint8_t port, value;
+} edge;
+static edge edges[MAX_EDGES];
+static int nedges;
+
+static void die(const char *msg, const char *arg) {
+  fprintf(stderr, "wstiming: %s%s\n", msg, arg ? arg : "");
+  exit(2);
+}
+
+static void dieAt(int line, const char *msg, const char *arg) {
+  fprintf(stderr, "wstiming: %s:%d: %s%s\n", srcName, line, msg, arg ? arg : "");
+  exit(2);
+}
+
+/*********************************************************************
+ * Assembly source
+ *********************************************************************/
+static long *symValue(const char *name) {
+  int i;
+  for (i = 0; i < nsyms; i++) {
+    if (!strcmp(syms[i].name, name)) {
+      return &syms[i].value;
+    }
+  }
+  return NULL;
+}
+
+static void addSym(const char *name, long value, int line) {
+  if (symValue(name)) {
+    dieAt(line, "defined twice: ", name);
+  }
+  if (nsyms == MAX_SYMS || strlen(name) >= sizeof(syms[0].name)) {
+    dieAt(line, "too many symbols at ", name);
+  }
+  strcpy(syms[nsyms].name, name);
+  syms[nsyms++].value = value;
+}
+
+// expressions: numbers, symbols, ( ) ~ - * / + - << >> & ^ |
+static const char *ex;
+static int exLine;
+static long exOr(void);
+
+static void exSpace(void) {
+  while (isspace((unsigned char)*ex)) {
+    ex++;
+  }
+}
+
+static long exAtom(void) {
+  char name[40];
+  long v, *p;
+  int n = 0;
+
+  exSpace();
+  if (*ex == '(') {
+    ex++;
+    v = exOr();
+    exSpace();
+    if (*ex++ != ')') {
+      dieAt(exLine, "missing ) in expression", NULL);
+    }
+    return v;
+  }
+  if (*ex == '~') {
+    ex++;
+    return ~exAtom();
+  }
+  if (*ex == '-') {
+    ex++;
+    return -exAtom();
+  }
+  if (isdigit((unsigned char)*ex)) {
+    v = strtol(ex, (char **)&ex, 0);
+    while (isalpha((unsigned char)*ex)) { // 16000000UL
+      ex++;
+    }
+    return v;
+  }
+  while ((isalnum((unsigned char)*ex) || *ex == '_') && n < (int)sizeof(name) - 1) {
+    name[n++] = *ex++;
+  }
+  name[n] = 0;
+  if (!n) {
+    dieAt(exLine, "bad expression at ", ex);
+  }
+  if (!strcmp(name, "led_brightness")) return ADDR_BRIGHTNESS;
+  if (!strcmp(name, "led_dither")) return ADDR_DITHER;
+  if (!strcmp(name, "led_dither_step")) return ADDR_DITHER_STEP;
+  p = symValue(name);
+  if (!p) {
+    dieAt(exLine, "unknown symbol ", name);
+  }
+  return *p;
+}
+
+static long exMul(void) {
+  long v = exAtom();
+  for (;;) {
+    exSpace();
+    if (*ex == '*') { ex++; v *= exAtom(); }
+    else if (*ex == '/') { ex++; v /= exAtom(); }
+    else return v;
+  }
+}
+
+static long exAdd(void) {
+  long v = exMul();
+  for (;;) {
+    exSpace();
+    if (*ex == '+') { ex++; v += exMul(); }
+    else if (*ex == '-') { ex++; v -= exMul(); }
+    else return v;
+  }
+}
+
+static long exShift(void) {
+  long v = exAdd();
+  for (;;) {
+    exSpace();
+    if (ex[0] == '<' && ex[1] == '<') { ex += 2; v <<= exAdd(); }
+    else if (ex[0] == '>' && ex[1] == '>') { ex += 2; v >>= exAdd(); }
+    else return v;
+  }
+}
+
+static long exAnd(void) {
+  long v = exShift();
+  for (;;) {
+    exSpace();
+    if (*ex == '&') { ex++; v &= exShift(); }
+    else return v;
+  }
+}
+
+static long exXor(void) {
+  long v = exAnd();
+  for (;;) {
+    exSpace();
+    if (*ex == '^') { ex++; v ^= exAnd(); }
+    else return v;
+  }
+}
+
+static long exOr(void) {
+  long v = exXor();
+  for (;;) {
+    exSpace();
+    if (*ex == '|') { ex++; v |= exXor(); }
+    else return v;
+  }
+}
+
+static long eval(const char *s, int line) {
+  long v;
+  ex = s;
+  exLine = line;
+  v = exOr();
+  exSpace();
+  if (*ex) {
+    dieAt(line, "junk after expression: ", ex);
+  }
+  return v;
+}
+
+static char *trim(char *s) {
+  char *e;
+  while (isspace((unsigned char)*s)) {
+    s++;
+  }
+  e = s + strlen(s);
+  while (e > s && isspace((unsigned char)e[-1])) {
+    *--e = 0;
+  }
+  return s;
+}
+
+// operands are kept as text until all the labels are known
+static char argText[MAX_INSNS][2][48];
+
+static void resolve(insn *in, int i) {
+  static const char *ptrs[] = {"X", "X+", "-X", "Y", "Y+", "-Y", "Z", "Z+", "-Z"};
+  const char *t;
+  int n, k;
+
+  for (n = 0; n < in->nargs; n++) {
+    t = argText[i][n];
+    if ((t[0] == 'r' || t[0] == 'R') && isdigit((unsigned char)t[1]) &&
+        (!t[2] || (isdigit((unsigned char)t[2]) && !t[3]))) {
+      in->a[n].kind = O_REG;
+      in->a[n].v = atoi(t + 1);
+      if (in->a[n].v > 31) {
+        dieAt(in->line, "no such register ", t);
+      }
+      continue;
+    }
+    for (k = 0; k < 9; k++) {
+      if (!strcmp(t, ptrs[k])) {
+        break;
+      }
+    }
+    if (k < 9) {
+      in->a[n].kind = O_PTR;
+      in->a[n].v = k;
+      continue;
+    }
+    in->a[n].kind = O_IMM;
+    in->a[n].v = eval(t, in->line);
+  }
+}
+
+static void load(const char *file, const char *cc) {
+  char cmd[1024], buf[512], *s, *c, *colon, *label;
+  FILE *f;
+  int line = 0, i;
+
+  snprintf(cmd, sizeof(cmd), "%s -E -P -x assembler-with-cpp -I%s '%s'", cc, INCDIR, file);
+  f = popen(cmd, "r");
+  if (!f) {
+    die("can't run ", cmd);
+  }
+  while (fgets(buf, sizeof(buf), f)) {
+    line++;
+    if ((c = strchr(buf, ';'))) {
+      *c = 0;
+    }
+    s = trim(buf);
+    // labels, maybe with an instruction after them
+    while ((colon = strchr(s, ':'))) {
+      *colon = 0;
+      label = trim(s);
+      for (c = label; *c && (isalnum((unsigned char)*c) || *c == '_'); c++);
+      if (*c || !*label) {
+        dieAt(line, "bad label ", label);
+      }
+      addSym(label, nprog, line);
+      s = trim(colon + 1);
+    }
+    if (!*s) {
+      continue;
+    }
+    if (*s == '.') {
+      if (!strncmp(s, ".equ", 4) || !strncmp(s, ".set", 4)) {
+        char *name = trim(s + 4), *comma = strchr(name, ',');
+        if (!comma) {
+          dieAt(line, "bad ", s);
+        }
+        *comma = 0;
+        addSym(trim(name), eval(trim(comma + 1), line), line);
+      }
+      continue; // .global, .section, ...
+    }
+    if (nprog == MAX_INSNS) {
+      dieAt(line, "too many instructions", NULL);
+    }
+    insn *in = &prog[nprog];
+    memset(in, 0, sizeof(*in));
+    in->line = line;
+    for (i = 0; *s && !isspace((unsigned char)*s) && i < (int)sizeof(in->op) - 1; i++) {
+      in->op[i] = tolower((unsigned char)*s++);
+    }
+    s = trim(s);
+    while (*s) {
+      if (in->nargs == 2) {
+        dieAt(line, "too many operands: ", s);
+      }
+      c = strchr(s, ',');
+      if (c) {
+        *c = 0;
+      }
+      snprintf(argText[nprog][in->nargs++], sizeof(argText[0][0]), "%s", trim(s));
+      s = c ? trim(c + 1) : s + strlen(s);
+    }
+    in->words = (!strcmp(in->op, "lds") || !strcmp(in->op, "sts")) ? 2 : 1;
+    nprog++;
+  }
+  if (pclose(f)) {
+    die("preprocessing failed: ", cmd);
+  }
+  for (i = 0; i < nprog; i++) {
+    resolve(&prog[i], i);
+  }
+}
+
+/*********************************************************************
+ * Simulator
+ *********************************************************************/
+static uint8_t getSreg(void) {
+  return (flagI << 7) | (flagT << 6) | ((flagN ^ flagV) << 4) | (flagV << 3) |
+         (flagN << 2) | (flagZ << 1) | flagC;
+}
+
+static void setSreg(uint8_t v) {
+  flagI = (v >> 7) & 1;
+  flagT = (v >> 6) & 1;
+  flagV = (v >> 3) & 1;
+  flagN = (v >> 2) & 1;
+  flagZ = (v >> 1) & 1;
+  flagC = v & 1;
+}
+
+static uint8_t ioRead(int a) {
+  if (a == SREG_ADDR) return getSreg();
+  if (a == 0x3D) return sp & 0xFF;
+  if (a == 0x3E) return sp >> 8;
+  return io[a];
+}
+
+static void ioWrite(int a, uint8_t v) {
+  if (a == SREG_ADDR) {
+    setSreg(v);
+    return;
+  }
+  if (a == 0x3D) { sp = (sp & 0xFF00) | v; return; }
+  if (a == 0x3E) { sp = (sp & 0x00FF) | (v << 8); return; }
+  if ((a == PORTB_ADDR || a == PORTC_ADDR || a == PORTD_ADDR) && io[a] != v) {
+    if (nedges == MAX_EDGES) {
+      die("too many pin changes", NULL);
+    }
+    edges[nedges].cycle = cycle;
+    edges[nedges].port = a;
+    edges[nedges++].value = v;
+  }
+  io[a] = v;
+}
+
+static uint8_t memRead(int a) {
+  if (a < 32) return r[a];
+  if (a < 0x60) return ioRead(a - 32);
+  if (a > RAMEND) die("read past the end of SRAM", NULL);
+  if (a == ADDR_BRIGHTNESS) readBrightness = 1;
+  return sram[a];
+}
+
+static void memWrite(int a, uint8_t v) {
+  if (a < 32) { r[a] = v; return; }
+  if (a < 0x60) { ioWrite(a - 32, v); return; }
+  if (a > RAMEND) die("write past the end of SRAM", NULL);
+  sram[a] = v;
+}
+
+static void push(uint8_t v) {
+  memWrite(sp--, v);
+}
+
+static uint8_t pop(void) {
+  return memRead(++sp);
+}
+
+static void flagsZN(uint8_t v) {
+  flagZ = (v == 0);
+  flagN = v >> 7;
+}
+
+static uint8_t doAdd(uint8_t a, uint8_t b, int c) {
+  unsigned s = a + b + c;
+  uint8_t v = s;
+  flagC = s > 0xFF;
+  flagV = ((a ^ v) & (b ^ v)) >> 7;
+  flagsZN(v);
+  return v;
+}
+
+static uint8_t doSub(uint8_t a, uint8_t b, int c, int keepZ) {
+  uint8_t v = a - b - c;
+  int z = flagZ;
+  flagC = (unsigned)b + c > a;
+  flagV = ((a ^ b) & (a ^ v)) >> 7;
+  flagsZN(v);
+  if (keepZ) {
+    flagZ = z && (v == 0);
+  }
+  return v;
+}
+
+// X, Y, Z pointer register pairs
+static int ptrBase(int mode) {
+  return mode <= P_MX ? 26 : mode <= P_MY ? 28 : 30;
+}
+
+static uint16_t ptrAccess(int mode) {
+  int b = ptrBase(mode);
+  uint16_t p = r[b] | (r[b + 1] << 8), at;
+  int kind = mode % 3; // 0 plain, 1 post-increment, 2 pre-decrement
+  if (kind == 2) {
+    p--;
+  }
+  at = p;
+  if (kind == 1) {
+    p++;
+  }
+  r[b] = p & 0xFF;
+  r[b + 1] = p >> 8;
+  return at;
+}
+
+static int reg(const insn *in, int n) {
+  if (in->a[n].kind != O_REG) {
+    dieAt(in->line, "register expected for ", in->op);
+  }
+  return in->a[n].v;
+}
+
+static long imm(const insn *in, int n) {
+  if (in->a[n].kind != O_IMM) {
+    dieAt(in->line, "value expected for ", in->op);
+  }
+  return in->a[n].v;
+}
+
+static int branch(const insn *in, int taken, int pc) {
+  if (taken) {
+    cycle += 2;
+    return imm(in, 0);
+  }
+  cycle += 1;
+  return pc + 1;
+}
+
+// call the routine at pc like avr-gcc would, until it returns
+static void run(int pc) {
+  sp = RAMEND;
+  push(RET_MARK & 0xFF);
+  push(RET_MARK >> 8);
+  cycle = 0;
+  nedges = 0;
+  readBrightness = 0;
+
+  for (;;) {
+    const insn *in;
+    const char *op;
+    int d, s, w;
+    unsigned p;
+
+    if (pc < 0 || pc >= nprog) {
+      die("ran off the end of the code", NULL);
+    }
+    if (cycle > MAX_CYCLES) {
+      dieAt(prog[pc].line, "no return after many cycles, stuck in a loop?", NULL);
+    }
+    in = &prog[pc];
+    op = in->op;
+
+    if (!strcmp(op, "nop")) {
+      cycle += 1; pc++;
+    } else if (!strcmp(op, "out")) {
+      ioWrite(imm(in, 0), r[reg(in, 1)]);
+      cycle += 1; pc++;
+    } else if (!strcmp(op, "in")) {
+      r[reg(in, 0)] = ioRead(imm(in, 1));
+      cycle += 1; pc++;
+    } else if (!strcmp(op, "mov")) {
+      r[reg(in, 0)] = r[reg(in, 1)];
+      cycle += 1; pc++;
+    } else if (!strcmp(op, "movw")) {
+      d = reg(in, 0); s = reg(in, 1);
+      r[d] = r[s]; r[d + 1] = r[s + 1];
+      cycle += 1; pc++;
+    } else if (!strcmp(op, "ldi")) {
+      d = reg(in, 0);
+      if (d < 16) dieAt(in->line, "ldi needs r16-r31", NULL);
+      r[d] = imm(in, 1);
+      cycle += 1; pc++;
+    } else if (!strcmp(op, "clr") || !strcmp(op, "eor")) {
+      d = reg(in, 0);
+      r[d] ^= (in->nargs == 1) ? r[d] : r[reg(in, 1)];
+      flagV = 0; flagsZN(r[d]);
+      cycle += 1; pc++;
+    } else if (!strcmp(op, "ori") || !strcmp(op, "andi") ||
+               !strcmp(op, "subi") || !strcmp(op, "cpi")) {
+      d = reg(in, 0);
+      if (d < 16) dieAt(in->line, "needs r16-r31: ", op);
+      w = imm(in, 1) & 0xFF;
+      if (op[0] == 'o') { r[d] |= w; flagV = 0; flagsZN(r[d]); }
+      else if (op[0] == 'a') { r[d] &= w; flagV = 0; flagsZN(r[d]); }
+      else if (op[0] == 's') { r[d] = doSub(r[d], w, 0, 0); }
+      else { doSub(r[d], w, 0, 0); }
+      cycle += 1; pc++;
+    } else if (!strcmp(op, "or") || !strcmp(op, "and")) {
+      d = reg(in, 0);
+      if (op[0] == 'o') r[d] |= r[reg(in, 1)]; else r[d] &= r[reg(in, 1)];
+      flagV = 0; flagsZN(r[d]);
+      cycle += 1; pc++;
+    } else if (!strcmp(op, "com")) {
+      d = reg(in, 0);
+      r[d] = ~r[d];
+      flagC = 1; flagV = 0; flagsZN(r[d]);
+      cycle += 1; pc++;
+    } else if (!strcmp(op, "add") || !strcmp(op, "adc")) {
+      d = reg(in, 0);
+      r[d] = doAdd(r[d], r[reg(in, 1)], op[1] == 'd' && op[2] == 'c' ? flagC : 0);
+      cycle += 1; pc++;
+    } else if (!strcmp(op, "lsl")) {
+      d = reg(in, 0);
+      r[d] = doAdd(r[d], r[d], 0);
+      cycle += 1; pc++;
+    } else if (!strcmp(op, "sub") || !strcmp(op, "sbc") ||
+               !strcmp(op, "cp") || !strcmp(op, "cpc")) {
+      d = reg(in, 0);
+      w = doSub(r[d], r[reg(in, 1)], (op[2] == 'c' || op[1] == 'b') ? flagC : 0,
+                op[2] == 'c' || op[1] == 'b');
+      if (op[0] == 's') r[d] = w;
+      cycle += 1; pc++;
+    } else if (!strcmp(op, "dec") || !strcmp(op, "inc")) {
+      d = reg(in, 0);
+      r[d] += (op[0] == 'i') ? 1 : -1;
+      flagV = (op[0] == 'i') ? (r[d] == 0x80) : (r[d] == 0x7F);
+      flagsZN(r[d]);
+      cycle += 1; pc++;
+    } else if (!strcmp(op, "swap")) {
+      d = reg(in, 0);
+      r[d] = (r[d] << 4) | (r[d] >> 4);
+      cycle += 1; pc++;
+    } else if (!strcmp(op, "set") || !strcmp(op, "clt")) {
+      flagT = (op[0] == 's');
+      cycle += 1; pc++;
+    } else if (!strcmp(op, "bst")) {
+      flagT = (r[reg(in, 0)] >> imm(in, 1)) & 1;
+      cycle += 1; pc++;
+    } else if (!strcmp(op, "bld")) {
+      d = reg(in, 0);
+      w = imm(in, 1);
+      r[d] = (r[d] & ~(1 << w)) | (flagT << w);
+      cycle += 1; pc++;
+    } else if (!strcmp(op, "sbrc") || !strcmp(op, "sbrs")) {
+      w = (r[reg(in, 0)] >> imm(in, 1)) & 1;
+      if (w == (op[3] == 's')) { // skip the next instruction
+        if (pc + 1 >= nprog) die("skip past the end of the code", NULL);
+        cycle += 1 + prog[pc + 1].words;
+        pc += 2;
+      } else {
+        cycle += 1; pc++;
+      }
+    } else if (!strcmp(op, "sbiw") || !strcmp(op, "adiw")) {
+      d = reg(in, 0);
+      p = r[d] | (r[d + 1] << 8);
+      w = imm(in, 1);
+      if (op[0] == 's') { flagC = (unsigned)w > p; p -= w; }
+      else { flagC = p + w > 0xFFFF; p += w; }
+      p &= 0xFFFF;
+      r[d] = p & 0xFF; r[d + 1] = p >> 8;
+      flagZ = (p == 0); flagN = p >> 15; flagV = 0;
+      cycle += 2; pc++;
+    } else if (!strcmp(op, "mul")) {
+      p = r[reg(in, 0)] * r[reg(in, 1)];
+      r[0] = p & 0xFF; r[1] = p >> 8;
+      flagC = p >> 15; flagZ = (p == 0);
+      cycle += 2; pc++;
+    } else if (!strcmp(op, "ld")) {
+      if (in->a[1].kind != O_PTR) dieAt(in->line, "ld needs X, Y or Z", NULL);
+      r[reg(in, 0)] = memRead(ptrAccess(in->a[1].v));
+      cycle += 2; pc++;
+    } else if (!strcmp(op, "st")) {
+      if (in->a[0].kind != O_PTR) dieAt(in->line, "st needs X, Y or Z", NULL);
+      memWrite(ptrAccess(in->a[0].v), r[reg(in, 1)]);
+      cycle += 2; pc++;
+    } else if (!strcmp(op, "lds")) {
+      r[reg(in, 0)] = memRead(imm(in, 1));
+      cycle += 2; pc++;
+    } else if (!strcmp(op, "sts")) {
+      memWrite(imm(in, 0), r[reg(in, 1)]);
+      cycle += 2; pc++;
+    } else if (!strcmp(op, "push")) {
+      push(r[reg(in, 0)]);
+      cycle += 2; pc++;
+    } else if (!strcmp(op, "pop")) {
+      r[reg(in, 0)] = pop();
+      cycle += 2; pc++;
+    } else if (!strcmp(op, "cli") || !strcmp(op, "sei")) {
+      flagI = (op[0] == 's');
+      cycle += 1; pc++;
+    } else if (!strcmp(op, "rjmp")) {
+      pc = imm(in, 0);
+      cycle += 2;
+    } else if (!strcmp(op, "breq")) {
+      pc = branch(in, flagZ, pc);
+    } else if (!strcmp(op, "brne")) {
+      pc = branch(in, !flagZ, pc);
+    } else if (!strcmp(op, "brcs") || !strcmp(op, "brlo")) {
+      pc = branch(in, flagC, pc);
+    } else if (!strcmp(op, "brcc") || !strcmp(op, "brsh")) {
+      pc = branch(in, !flagC, pc);
+    } else if (!strcmp(op, "brts")) {
+      pc = branch(in, flagT, pc);
+    } else if (!strcmp(op, "brtc")) {
+      pc = branch(in, !flagT, pc);
+    } else if (!strcmp(op, "ret")) {
+      cycle += 4;
+      p = pop() << 8;
+      p |= pop();
+      if (p != RET_MARK) {
+        dieAt(in->line, "ret to the wrong address, stack out of step", NULL);
+      }
+      return;
+    } else {
+      dieAt(in->line, "the simulator doesn't know ", op);
+    }
+  }
+}
+
+/*********************************************************************
+ * Routines, and how to call them
+ *********************************************************************/
+enum { CALL_PLAIN, CALL_34, CALL_34S, CALL_PAL, CALL_PAL4 };
+
+typedef struct {
+  const char *name;
+  int call;
+} routine;
+
+static const routine calls[] = {
+  { "output_grb34",   CALL_34 },
+  { "output_grb34s",  CALL_34S },
+  { "output_grb_pal", CALL_PAL },
+  { "output_grb_pal4", CALL_PAL4 },
+};
+
+static int callOf(const char *name) {
+  int i;
+  for (i = 0; i < (int)(sizeof(calls) / sizeof(calls[0])); i++) {
+    if (!strcmp(calls[i].name, name)) {
+      return calls[i].call;
+    }
+  }
+  return CALL_PLAIN; // (u08 * ptr, u16 count), one pin
+}
+
+static void arg16(int n, unsigned v) {
+  int rr = 24 - 2 * n; // r24, r22, r20, r18
+  r[rr] = v & 0xFF;
+  r[rr + 1] = v >> 8;
+}
+
+// results of the pulses of one routine
+typedef struct {
+  long t0h[2], t1h[2], t0l[2], t1l[2]; // min, max in cycles
+  long bits, bad;
+} stats;
+
+static void statAdd(long *mm, long v) {
+  if (mm[0] < 0 || v < mm[0]) mm[0] = v;
+  if (mm[1] < 0 || v > mm[1]) mm[1] = v;
+}
+
+static void badPulse(stats *st, const char *what, long bit, long cycles) {
+  st->bad++;
+  if (verbose) {
+    fprintf(stderr, "  bit %ld: %s %ld cycles, %ldns\n", bit, what, cycles, NS(cycles));
+  }
+}
+
+/*********************************************************************
+ * Check the pulses of one pin against the bytes it should have sent.
+ * Returns the number of bits that came out wrong, or -1 if there were
+ * more or fewer bits than that.
+ *********************************************************************/
+static long checkPin(int port, int bit, const uint8_t *want, int count, stats *st,
+                     long *first, long *last) {
+  long rise = -1, fall = -1, nbit = 0, wrong = 0, th, tl;
+  int prevBit = -1, level = 0, i, b;
+
+  for (i = 0; i < nedges; i++) {
+    if (edges[i].port != port) {
+      continue;
+    }
+    b = (edges[i].value >> bit) & 1;
+    if (b == level) {
+      continue;
+    }
+    level = b;
+    if (b) {
+      if (fall >= 0) { // the low time of the bit before
+        tl = edges[i].cycle - fall;
+        if (prevBit) {
+          statAdd(st->t1l, tl);
+          if (NS(tl) < T1L_MIN_NS || NS(tl) > TL_MAX_NS) badPulse(st, "'1' low", nbit - 1, tl);
+        } else {
+          statAdd(st->t0l, tl);
+          if (NS(tl) < T0L_MIN_NS || NS(tl) > TL_MAX_NS) badPulse(st, "'0' low", nbit - 1, tl);
+        }
+      }
+      rise = edges[i].cycle;
+      if (*first < 0) *first = rise;
+    } else {
+      fall = edges[i].cycle;
+      *last = fall;
+      th = fall - rise;
+      // the LED's decision point is between the two windows
+      prevBit = NS(th) >= (T0H_MAX_NS + T1H_MIN_NS) / 2;
+      if (prevBit) {
+        statAdd(st->t1h, th);
+        if (NS(th) < T1H_MIN_NS || NS(th) > T1H_MAX_NS) badPulse(st, "'1' high", nbit, th);
+      } else {
+        statAdd(st->t0h, th);
+        if (NS(th) < T0H_MIN_NS || NS(th) > T0H_MAX_NS) badPulse(st, "'0' high", nbit, th);
+      }
+      if (nbit < 8L * count && prevBit != ((want[nbit / 8] >> (7 - nbit % 8)) & 1)) {
+        wrong++;
+      }
+      nbit++;
+    }
+  }
+  if (level) {
+    wrong++; // left high
+  }
+  st->bits += nbit;
+  return (nbit == 8L * count) ? wrong : -1;
+}
+
+// what the routine should send, scaled where it scales: each byte
+// (lane 1 then lane 2 for each pair) moves the dither on. Returns the
+// dither after the last byte.
+static uint8_t expect(uint8_t *out, const uint8_t *in, uint8_t *out2, const uint8_t *in2,
+                      int count, uint8_t d) {
+  uint8_t b = sram[ADDR_BRIGHTNESS], step = sram[ADDR_DITHER_STEP];
+  int i;
+
+  for (i = 0; i < count; i++) {
+    out[i] = readBrightness ? (in[i] * b + d) >> 8 : in[i];
+    d += step;
+    if (in2) {
+      out2[i] = readBrightness ? (in2[i] * b + d) >> 8 : in2[i];
+      d += step;
+    }
+  }
+  return d;
+}
+
+static int pinOf(uint8_t mask) {
+  int b;
+  for (b = 0; b < 8; b++) {
+    if (mask == (1 << b)) return b;
+  }
+  return -1;
+}
+
+/*********************************************************************
+ * One call of a routine with count bytes (LEDs for the palette ones) of
+ * random data. Returns the number of things wrong, and sets *cycles to
+ * the frame time, first rising edge to last falling one.
+ *********************************************************************/
+static int trial(const char *name, int pc, int count, stats *st, long *cycles) {
+  static uint8_t data[2 * NUM_LEDS + 64], want[NUM_LEDS], want2[NUM_LEDS];
+  uint8_t saved[32], before[64], sregBefore, mask = 0, dither, d, port = 0, changed = 0;
+  int call = callOf(name), i, stride = count, fails = 0, pin, pin2 = -1;
+  long wrong, first = -1, last = -1;
+  unsigned palAddr = 0;
+
+  for (i = 0; i < 32; i++) r[i] = rand();
+  r[1] = 0; // avr-gcc's zero register
+  for (i = 0; i < 64; i++) io[i] = rand();
+  // the data pins are low between frames
+  io[PORTB_ADDR] &= ~DATA_PINS;
+  io[PORTC_ADDR] &= ~DATA_PINS;
+  io[PORTD_ADDR] &= ~DATA_PINS;
+  flagI = 1;
+  sram[ADDR_BRIGHTNESS] = rand();
+  sram[ADDR_DITHER] = dither = rand();
+  sram[ADDR_DITHER_STEP] = (rand() & 1) ? rand() : 0;
+  for (i = 0; i < (int)sizeof(data); i++) data[i] = rand();
+
+  arg16(0, ADDR_BUF);
+  arg16(1, count);
+  if (call == CALL_34S) {
+    stride = count + rand() % 8; // anywhere after the upper lane's data
+    arg16(2, stride);
+  } else if (call == CALL_PAL) { // indexes, then a 16 entry palette
+    mask = 1 << (3 + rand() % 2);
+    for (i = 0; i < count; i++) data[i] %= 16;
+    palAddr = ADDR_BUF + count;
+    arg16(2, palAddr);
+    arg16(3, mask);
+  } else if (call == CALL_PAL4) { // 2 indexes per byte, then the palette
+    mask = 1 << (3 + rand() % 2);
+    palAddr = ADDR_BUF + (count + 1) / 2;
+    arg16(2, palAddr);
+    arg16(3, mask);
+  }
+  memcpy(&sram[ADDR_BUF], data, sizeof(data));
+  memcpy(saved, r, 32);
+  memcpy(before, io, 64);
+  sregBefore = getSreg();
+
+  run(pc);
+  callCycles = cycle;
+
+  if (call == CALL_PAL) {
+    for (i = 0; i < 3 * count; i++) want[i] = data[count + 3 * data[i / 3] + i % 3];
+    count *= 3;
+  } else if (call == CALL_PAL4) {
+    for (i = 0; i < 3 * count; i++) {
+      d = data[i / 6];
+      d = (i % 6 < 3) ? d >> 4 : d & 0x0F; // high nibble first
+      want[i] = data[(count + 1) / 2 + 3 * d + i % 3];
+    }
+    count *= 3;
+  } else {
+    d = expect(want, data, want2, (call == CALL_PLAIN) ? NULL : data + stride, count, dither);
+    if (readBrightness && sram[ADDR_DITHER] != d) {
+      fprintf(stderr, "  %s: led_dither left at %d, should be %d\n", name, sram[ADDR_DITHER], d);
+      fails++;
+    }
+  }
+
+  // which pins toggled
+  for (i = 0; i < nedges; i++) {
+    if (port && edges[i].port != port) {
+      fprintf(stderr, "  %s: wrote to more than one port\n", name);
+      return fails + 1;
+    }
+    port = edges[i].port;
+    changed |= edges[i].value ^ before[port];
+  }
+  if (!port) {
+    fprintf(stderr, "  %s: no output\n", name);
+    return fails + 1;
+  }
+  if ((call == CALL_PAL || call == CALL_PAL4) && changed != mask) {
+    fprintf(stderr, "  %s: toggled pins 0x%02x, outmask was 0x%02x\n", name, changed, mask);
+    return fails + 1;
+  }
+  if (call == CALL_34 || call == CALL_34S) { // the lower pin is the upper string
+    pin = pinOf(changed & -changed);
+    pin2 = pinOf(changed & ~(changed & -changed));
+  } else {
+    pin = pinOf(changed);
+  }
+  if (pin < 0 || ((call == CALL_34 || call == CALL_34S) && pin2 < 0)) {
+    fprintf(stderr, "  %s: toggled pins 0x%02x\n", name, changed);
+    return fails + 1;
+  }
+  if ((io[port] & ~changed) != (before[port] & ~changed)) {
+    fprintf(stderr, "  %s: changed other pins of the port\n", name);
+    fails++;
+  }
+
+  wrong = checkPin(port, pin, want, count, st, &first, &last);
+  if (wrong) {
+    fprintf(stderr, "  %s: count %d, %s\n", name, count,
+            wrong < 0 ? "wrong number of bits" : "bits sent wrong");
+    fails++;
+  }
+  if (pin2 >= 0) {
+    wrong = checkPin(port, pin2, want2, count, st, &first, &last);
+    if (wrong) {
+      fprintf(stderr, "  %s: count %d, second lane %s\n", name, count,
+              wrong < 0 ? "wrong number of bits" : "bits sent wrong");
+      fails++;
+    }
+  }
+  if (flagI != (sregBefore >> 7)) { // the other flags are the caller's to lose
+    fprintf(stderr, "  %s: interrupt flag not restored\n", name);
+    fails++;
+  }
+  if (r[1]) {
+    fprintf(stderr, "  %s: r1 not cleared\n", name);
+    fails++;
+  }
+  for (i = 2; i < 30; i++) {
+    if ((i <= 17 || i >= 28) && r[i] != saved[i]) {
+      fprintf(stderr, "  %s: call-saved r%d changed\n", name, i);
+      fails++;
+    }
+  }
+  if (sp != RAMEND) {
+    fprintf(stderr, "  %s: stack not back where it was\n", name);
+    fails++;
+  }
+  *cycles = last - first;
+  return fails;
+}
+
+static void printRange(const char *what, const long *mm) {
+  if (mm[0] < 0) {
+    printf("  %s     -\n", what);
+  } else {
+    printf("  %s %3ld-%3ld cycles  %4ld-%4ldns\n", what, mm[0], mm[1], NS(mm[0]), NS(mm[1]));
+  }
+}
+
+static void usage(void) {
+  fprintf(stderr, "usage: wstiming [-n runs] [-s seed] [-v] [-c] file.s symbol [symbol...]\n");
+  exit(2);
+}
+
+int main(int argc, char **argv) {
+  const char *cc = getenv("CC") ? getenv("CC") : "cc";
+  int runs = 200, seed = 1, csv = 0, i, n, fails = 0, count, full;
+  long *pc, cycles;
+  stats st;
+
+  for (i = 1; i < argc && argv[i][0] == '-'; i++) {
+    if (!strcmp(argv[i], "-n") && i + 1 < argc) {
+      runs = atoi(argv[++i]);
+    } else if (!strcmp(argv[i], "-s") && i + 1 < argc) {
+      seed = atoi(argv[++i]);
+    } else if (!strcmp(argv[i], "-v")) {
+      verbose = 1;
+    } else if (!strcmp(argv[i], "-c")) {
+      csv = 1;
+    } else {
+      usage();
+    }
+  }
+  if (argc - i < 2 || runs < 1) {
+    usage();
+  }
+  srcName = argv[i];
+  load(argv[i++], cc);
+  srand(seed);
+
+  for (; i < argc; i++) {
+    int bad = 0, leds;
+    pc = symValue(argv[i]);
+    if (!pc) {
+      die("no such routine: ", argv[i]);
+    }
+    memset(&st, 0, sizeof(st));
+    memset(st.t0h, -1, sizeof(st.t0h)); memset(st.t1h, -1, sizeof(st.t1h));
+    memset(st.t0l, -1, sizeof(st.t0l)); memset(st.t1l, -1, sizeof(st.t1l));
+    leds = (callOf(argv[i]) == CALL_PAL) || (callOf(argv[i]) == CALL_PAL4);
+    full = leds ? NUM_LEDS / 3 : NUM_LEDS;
+    for (n = 0; n < runs; n++) {
+      count = 1 + rand() % ((n & 1) ? 8 : 64); // short ones hit the ends more
+      bad += trial(argv[i], *pc, count, &st, &cycles) != 0;
+    }
+    bad += trial(argv[i], *pc, full, &st, &cycles) != 0;
+    if (bad || st.bad) {
+      fails++;
+    }
+    if (csv) {
+      printf("%s,%s,%d,%s,%ld,%ld,%.3f\n", srcName, argv[i], full,
+             leds ? "LEDs" : "bytes", callCycles, cycles, callCycles * 1000.0 / F_CPU);
+      continue;
+    }
+    printf("%s %s: %ld bits, %ld out of window, %d of %d calls failed\n",
+           srcName, argv[i], st.bits, st.bad, bad, runs + 1);
+    printRange("T0H", st.t0h);
+    printRange("T1H", st.t1h);
+    printRange("T0L", st.t0l);
+    printRange("T1L", st.t1l);
+    printf("  %d %s: %ld cycles, %.2fms\n", full,
+           leds ? "LEDs" : "bytes",
+           cycles, cycles * 1000.0 / F_CPU);
+  }
+  return fails ? 1 : 0;
+}